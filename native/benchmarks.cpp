@@ -0,0 +1,353 @@
+// Micro-benchmarks for the hot paths of the core, built by the native host target.
+//
+// Usage: esphomelib_benchmarks [--filter <substring>] [--min-time <ms>] [--json <file>]
+//                              [--baseline <file>] [--threshold <percent>]
+//
+// Each benchmark is run in batches until at least --min-time has passed, the best of five such runs is
+// reported in ns/op together with the heap allocations per op. --json writes the results as JSON, which can
+// later be passed as --baseline: the run then fails if any benchmark got more than --threshold percent slower.
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <functional>
+#include <new>
+#include <string>
+#include <vector>
+
+#include "esphomelib/api/util.h"
+#include "esphomelib/automation.h"
+#include "esphomelib/component.h"
+#include "esphomelib/helpers.h"
+#include "esphomelib/mqtt/mqtt_topic.h"
+#include "esphomelib/sensor/filter.h"
+#include "esphomelib/sensor/sensor.h"
+
+using namespace esphomelib;
+
+static uint64_t benchmark_allocations = 0;
+
+void *operator new(size_t size) {
+  benchmark_allocations++;
+  void *ptr = malloc(size == 0 ? 1 : size);
+  if (ptr == nullptr)
+    throw std::bad_alloc();
+  return ptr;
+}
+void operator delete(void *ptr) noexcept {
+  free(ptr);
+}
+void operator delete(void *ptr, size_t) noexcept {
+  free(ptr);
+}
+
+/// Keep the compiler from optimizing a result away.
+template<typename T>
+static void do_not_optimize(const T &value) {
+  asm volatile("" : : "g"(&value) : "memory");
+}
+
+struct Benchmark {
+  const char *name;
+  /// Run the operation iterations times.
+  std::function<void(uint32_t iterations)> run;
+};
+
+/// A component with intervals that do (almost) nothing, to measure the overhead of the component loop.
+class TimerComponent : public Component {
+ public:
+  TimerComponent(uint32_t timers, uint32_t *counter) {
+    for (uint32_t i = 0; i < timers; i++)
+      this->set_interval(10 * (i + 1), [counter]() { (*counter)++; });
+  }
+};
+
+/// Run the loop of components components with timers intervals each, one op is one pass over all components.
+static void run_component_loop(uint32_t components, uint32_t timers, uint32_t iterations) {
+  uint32_t counter = 0;
+  std::vector<TimerComponent *> list;
+  for (uint32_t i = 0; i < components; i++)
+    list.push_back(new TimerComponent(timers, &counter));
+  for (uint32_t i = 0; i < iterations; i++) {
+    for (TimerComponent *component : list)
+      component->loop_();
+    // like a loop() with short component loops, so that intervals are due from time to time
+    delay(1);
+  }
+  for (TimerComponent *component : list)
+    delete component;
+  do_not_optimize(counter);
+}
+
+struct BenchmarkResult {
+  std::string name;
+  double ns_per_op;
+  double allocs_per_op;
+};
+
+static std::vector<Benchmark> make_benchmarks() {
+  std::vector<Benchmark> benchmarks;
+
+  benchmarks.push_back({"Component/loop/10_components_2_timers", [](uint32_t iterations) {
+    run_component_loop(10, 2, iterations);
+  }});
+  benchmarks.push_back({"Component/loop/50_components_4_timers", [](uint32_t iterations) {
+    run_component_loop(50, 4, iterations);
+  }});
+
+  benchmarks.push_back({"topic_match/exact", [](uint32_t iterations) {
+    for (uint32_t i = 0; i < iterations; i++)
+      do_not_optimize(mqtt::topic_match("livingroom/light/ceiling/command", "livingroom/light/ceiling/command"));
+  }});
+  benchmarks.push_back({"topic_match/single_level_wildcard", [](uint32_t iterations) {
+    for (uint32_t i = 0; i < iterations; i++)
+      do_not_optimize(mqtt::topic_match("livingroom/light/ceiling/command", "livingroom/+/+/command"));
+  }});
+  benchmarks.push_back({"topic_match/multi_level_wildcard", [](uint32_t iterations) {
+    for (uint32_t i = 0; i < iterations; i++)
+      do_not_optimize(mqtt::topic_match("livingroom/light/ceiling/command", "livingroom/#"));
+  }});
+  benchmarks.push_back({"topic_match/mismatch", [](uint32_t iterations) {
+    for (uint32_t i = 0; i < iterations; i++)
+      do_not_optimize(mqtt::topic_match("livingroom/light/ceiling/command", "livingroom/light/ceiling/state"));
+  }});
+
+  benchmarks.push_back({"APIBuffer/encode_uint32", [](uint32_t iterations) {
+    uint8_t buffer[64];
+    for (uint32_t i = 0; i < iterations; i++) {
+      api::APIBuffer buf(buffer, sizeof(buffer));
+      buf.encode_uint32(1, i);
+      buf.encode_uint32(2, 300);
+      buf.encode_uint32(3, 0xFFFFFFFF);
+      do_not_optimize(buf.get_length());
+    }
+  }});
+  benchmarks.push_back({"APIBuffer/encode_float", [](uint32_t iterations) {
+    uint8_t buffer[64];
+    for (uint32_t i = 0; i < iterations; i++) {
+      api::APIBuffer buf(buffer, sizeof(buffer));
+      buf.encode_fixed32(1, 0x12345678);
+      buf.encode_float(2, 21.5f);
+      buf.encode_bool(3, true);
+      do_not_optimize(buf.get_length());
+    }
+  }});
+  benchmarks.push_back({"APIBuffer/encode_string", [](uint32_t iterations) {
+    uint8_t buffer[128];
+    const std::string object_id = "livingroom_temperature";
+    for (uint32_t i = 0; i < iterations; i++) {
+      api::APIBuffer buf(buffer, sizeof(buffer));
+      buf.encode_string(1, object_id);
+      buf.encode_string(2, "Livingroom Temperature");
+      do_not_optimize(buf.get_length());
+    }
+  }});
+  benchmarks.push_back({"APIBuffer/encode_nested", [](uint32_t iterations) {
+    uint8_t buffer[128];
+    for (uint32_t i = 0; i < iterations; i++) {
+      api::APIBuffer buf(buffer, sizeof(buffer));
+      size_t begin = buf.begin_nested(1);
+      buf.encode_fixed32(1, 0x12345678);
+      buf.encode_float(2, 21.5f);
+      buf.end_nested(begin);
+      do_not_optimize(buf.get_length());
+    }
+  }});
+
+#ifndef ESPHOMELIB_HOST_NO_JSON
+  benchmarks.push_back({"build_json/light_state", [](uint32_t iterations) {
+    for (uint32_t i = 0; i < iterations; i++) {
+      size_t len;
+      const char *json = build_json([](JsonObject &root) {
+        root["state"] = "ON";
+        root["brightness"] = 255;
+        JsonObject &color = root.createNestedObject("color");
+        color["r"] = 255;
+        color["g"] = 128;
+        color["b"] = 0;
+        root["effect"] = "None";
+      }, &len);
+      do_not_optimize(json);
+    }
+  }});
+  benchmarks.push_back({"build_json/discovery", [](uint32_t iterations) {
+    for (uint32_t i = 0; i < iterations; i++) {
+      size_t len;
+      const char *json = build_json([](JsonObject &root) {
+        root["name"] = "Livingroom Temperature";
+        root["state_topic"] = "livingroom/sensor/livingroom_temperature/state";
+        root["availability_topic"] = "livingroom/status";
+        root["unit_of_measurement"] = "°C";
+        root["icon"] = "mdi:thermometer";
+        root["unique_id"] = "ESPsensorlivingroom_temperature";
+        JsonObject &device = root.createNestedObject("device");
+        device["identifiers"] = "020000000001";
+        device["name"] = "livingroom";
+        device["sw_version"] = "esphomelib v" ESPHOMELIB_VERSION;
+      }, &len);
+      do_not_optimize(json);
+    }
+  }});
+#endif
+
+  benchmarks.push_back({"Sensor/publish_state/no_filters", [](uint32_t iterations) {
+    sensor::Sensor sensor("bench");
+    sensor.clear_filters();
+    float sum = 0;
+    sensor.add_on_state_callback([&sum](float value) { sum += value; });
+    for (uint32_t i = 0; i < iterations; i++)
+      sensor.publish_state(float(i & 0xFF));
+    do_not_optimize(sum);
+  }});
+  benchmarks.push_back({"Sensor/publish_state/filter_chain", [](uint32_t iterations) {
+    sensor::Sensor sensor("bench");
+    sensor.set_filters({
+        new sensor::OffsetFilter(-2.0f),
+        new sensor::MultiplyFilter(1.8f),
+        new sensor::SlidingWindowMovingAverageFilter(15, 15),
+        new sensor::DeltaFilter(0.1f),
+    });
+    float sum = 0;
+    sensor.add_on_state_callback([&sum](float value) { sum += value; });
+    for (uint32_t i = 0; i < iterations; i++)
+      sensor.publish_state(float(i & 0xFF));
+    do_not_optimize(sum);
+  }});
+
+  return benchmarks;
+}
+
+static double run_seconds(const Benchmark &benchmark, uint32_t iterations) {
+  auto start = std::chrono::steady_clock::now();
+  benchmark.run(iterations);
+  auto end = std::chrono::steady_clock::now();
+  return std::chrono::duration<double>(end - start).count();
+}
+
+static BenchmarkResult run_benchmark(const Benchmark &benchmark, double min_time) {
+  // Find an iteration count that takes at least min_time.
+  uint32_t iterations = 1;
+  while (true) {
+    double elapsed = run_seconds(benchmark, iterations);
+    if (elapsed >= min_time || iterations >= (1UL << 30))
+      break;
+    uint64_t next = elapsed <= 0 ? uint64_t(iterations) * 10 : uint64_t(iterations * min_time / elapsed * 1.2) + 1;
+    iterations = uint32_t(std::min<uint64_t>(std::max<uint64_t>(next, iterations * 2ULL), 1UL << 30));
+  }
+
+  double best = 0;
+  uint64_t allocations = 0;
+  for (int i = 0; i < 5; i++) {
+    uint64_t allocations_before = benchmark_allocations;
+    double elapsed = run_seconds(benchmark, iterations);
+    allocations = benchmark_allocations - allocations_before;
+    if (i == 0 || elapsed < best)
+      best = elapsed;
+  }
+
+  return {benchmark.name, best * 1e9 / iterations, double(allocations) / iterations};
+}
+
+static bool write_json(const char *path, const std::vector<BenchmarkResult> &results) {
+  FILE *file = fopen(path, "w");
+  if (file == nullptr) {
+    fprintf(stderr, "Could not open %s for writing.\n", path);
+    return false;
+  }
+  // One benchmark per line, read_baseline() depends on that.
+  fprintf(file, "{\n  \"version\": \"%s\",\n  \"benchmarks\": [\n", ESPHOMELIB_VERSION);
+  for (size_t i = 0; i < results.size(); i++) {
+    fprintf(file, "    {\"name\": \"%s\", \"ns_per_op\": %.3f, \"allocs_per_op\": %.3f}%s\n",
+            results[i].name.c_str(), results[i].ns_per_op, results[i].allocs_per_op,
+            i + 1 < results.size() ? "," : "");
+  }
+  fprintf(file, "  ]\n}\n");
+  fclose(file);
+  return true;
+}
+
+static bool read_baseline(const char *path, std::vector<BenchmarkResult> *results) {
+  FILE *file = fopen(path, "r");
+  if (file == nullptr) {
+    fprintf(stderr, "Could not open baseline %s.\n", path);
+    return false;
+  }
+  char line[512];
+  while (fgets(line, sizeof(line), file) != nullptr) {
+    char name[256];
+    double ns_per_op, allocs_per_op;
+    const char *start = strstr(line, "{\"name\"");
+    if (start == nullptr)
+      continue;
+    if (sscanf(start, "{\"name\": \"%255[^\"]\", \"ns_per_op\": %lf, \"allocs_per_op\": %lf",
+               name, &ns_per_op, &allocs_per_op) == 3)
+      results->push_back({name, ns_per_op, allocs_per_op});
+  }
+  fclose(file);
+  return true;
+}
+
+int main(int argc, char **argv) {
+  const char *filter = nullptr;
+  const char *json_path = nullptr;
+  const char *baseline_path = nullptr;
+  double min_time = 0.1;
+  double threshold = 10.0;
+
+  for (int i = 1; i < argc; i++) {
+    bool has_value = i + 1 < argc;
+    if (strcmp(argv[i], "--filter") == 0 && has_value) {
+      filter = argv[++i];
+    } else if (strcmp(argv[i], "--json") == 0 && has_value) {
+      json_path = argv[++i];
+    } else if (strcmp(argv[i], "--baseline") == 0 && has_value) {
+      baseline_path = argv[++i];
+    } else if (strcmp(argv[i], "--min-time") == 0 && has_value) {
+      min_time = atof(argv[++i]) / 1000.0;
+    } else if (strcmp(argv[i], "--threshold") == 0 && has_value) {
+      threshold = atof(argv[++i]);
+    } else {
+      fprintf(stderr, "Usage: %s [--filter <substring>] [--min-time <ms>] [--json <file>] "
+                      "[--baseline <file>] [--threshold <percent>]\n", argv[0]);
+      return 2;
+    }
+  }
+
+  std::vector<BenchmarkResult> baseline;
+  if (baseline_path != nullptr && !read_baseline(baseline_path, &baseline))
+    return 2;
+
+  std::vector<BenchmarkResult> results;
+  int regressions = 0;
+  printf("%-40s %12s %12s %10s\n", "benchmark", "ns/op", "allocs/op", "change");
+  for (const Benchmark &benchmark : make_benchmarks()) {
+    if (filter != nullptr && strstr(benchmark.name, filter) == nullptr)
+      continue;
+
+    BenchmarkResult result = run_benchmark(benchmark, min_time);
+    results.push_back(result);
+
+    char change[32] = "";
+    for (const BenchmarkResult &base : baseline) {
+      if (base.name != result.name || base.ns_per_op <= 0)
+        continue;
+      double percent = (result.ns_per_op / base.ns_per_op - 1.0) * 100.0;
+      bool regression = percent > threshold;
+      if (regression)
+        regressions++;
+      snprintf(change, sizeof(change), "%+.1f%%%s", percent, regression ? " !" : "");
+    }
+    printf("%-40s %12.2f %12.2f %10s\n", result.name.c_str(), result.ns_per_op, result.allocs_per_op, change);
+  }
+
+  if (json_path != nullptr && !write_json(json_path, results))
+    return 2;
+
+  if (regressions != 0) {
+    printf("%d benchmark(s) got more than %.1f%% slower than the baseline.\n", regressions, threshold);
+    return 1;
+  }
+  return 0;
+}
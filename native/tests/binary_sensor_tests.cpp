@@ -0,0 +1,57 @@
+// Tests of the binary sensor multi click trigger, with its timers run by the global action scheduler on the
+// virtual clock.
+
+#include "test.h"
+#include "esphomelib/binary_sensor/binary_sensor.h"
+
+using namespace esphomelib;
+using namespace esphomelib::binary_sensor;
+
+/// A single click: pressed for 50-350ms, then released for at least 250ms.
+static const std::vector<MultiClickTriggerEvent> SINGLE_CLICK = {
+    {true, 50, 350},
+    {false, 250, 4294967294UL},
+};
+
+struct MultiClickFixture {
+  MultiClickFixture() : trigger(sensor.make_multi_click_trigger(SINGLE_CLICK)), automation(trigger) {
+    this->automation.add_actions({new LambdaAction<NoArg>([this](NoArg) { this->clicks++; })});
+  }
+
+  /// Keep the sensor in state for ms, running the scheduler every ms.
+  void hold(bool state, uint32_t ms) {
+    this->sensor.publish_state(state);
+    for (uint32_t i = 0; i < ms; i++) {
+      delay(1);
+      global_action_scheduler.loop_();
+    }
+  }
+
+  BinarySensor sensor{"Button"};
+  MultiClickTrigger *trigger;
+  Automation<NoArg> automation;
+  int clicks{0};
+};
+
+TEST_CASE(multi_click_single_click) {
+  MultiClickFixture f;
+  f.hold(false, 100);
+  f.hold(true, 100);
+  f.hold(false, 400);
+  EXPECT_EQ(f.clicks, 1);
+  // too long a press is not a click
+  f.hold(true, 500);
+  f.hold(false, 1500);
+  EXPECT_EQ(f.clicks, 1);
+}
+
+TEST_CASE(multi_click_initial_state) {
+  MultiClickFixture f;
+  // the button is held at boot: the first state is ON, and releasing it is not a click
+  f.hold(true, 100);
+  f.hold(false, 400);
+  EXPECT_EQ(f.clicks, 0);
+  f.hold(true, 100);
+  f.hold(false, 400);
+  EXPECT_EQ(f.clicks, 1);
+}
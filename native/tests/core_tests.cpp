@@ -0,0 +1,156 @@
+// Tests for the hardware independent core: MQTT topic matching, API buffer encoding, the sensor filter
+// chain, component timers on the virtual clock, component names and script run tracking.
+
+#include <vector>
+
+#include "test.h"
+#include "esphomelib/api/util.h"
+#include "esphomelib/automation.h"
+#include "esphomelib/component.h"
+#include "esphomelib/mqtt/mqtt_topic.h"
+#include "esphomelib/sensor/sensor.h"
+
+using namespace esphomelib;
+
+TEST_CASE(topic_match) {
+  EXPECT(mqtt::topic_match("a/b/c", "a/b/c"));
+  EXPECT(!mqtt::topic_match("a/b/c", "a/b"));
+  EXPECT(!mqtt::topic_match("a/b", "a/b/c"));
+  EXPECT(mqtt::topic_match("a/b/c", "a/+/c"));
+  EXPECT(mqtt::topic_match("a/b/c", "+/+/+"));
+  EXPECT(!mqtt::topic_match("a/b/c", "+/+"));
+  EXPECT(mqtt::topic_match("a/b/c", "a/#"));
+  EXPECT(mqtt::topic_match("a/b/c", "#"));
+  // topics starting with $ are only matched by wildcards after the first level
+  EXPECT(!mqtt::topic_match("$SYS/broker", "#"));
+  EXPECT(!mqtt::topic_match("$SYS/broker", "+/broker"));
+  EXPECT(mqtt::topic_match("$SYS/broker", "$SYS/#"));
+}
+
+TEST_CASE(api_buffer_varint) {
+  uint8_t buffer[16];
+  api::APIBuffer buf(buffer, sizeof(buffer));
+  buf.encode_uint32(1, 300);
+  EXPECT_EQ(buf.get_length(), 3u);
+  EXPECT_EQ(int(buffer[0]), 0x08);
+  EXPECT_EQ(int(buffer[1]), 0xAC);
+  EXPECT_EQ(int(buffer[2]), 0x02);
+
+  uint32_t consumed;
+  auto value = api::proto_decode_varuint32(&buffer[1], 2, &consumed);
+  EXPECT(value.has_value());
+  EXPECT_EQ(*value, 300u);
+  EXPECT_EQ(consumed, 2u);
+}
+
+TEST_CASE(api_buffer_overflow) {
+  uint8_t buffer[4];
+  api::APIBuffer buf(buffer, sizeof(buffer));
+  buf.encode_string(1, "too long for the buffer");
+  EXPECT(buf.get_overflow());
+}
+
+TEST_CASE(sensor_filter_chain) {
+  sensor::Sensor sensor("test");
+  sensor.set_filters({
+      new sensor::OffsetFilter(1.0f),
+      new sensor::MultiplyFilter(2.0f),
+      new sensor::SlidingWindowMovingAverageFilter(4, 2),
+  });
+  std::vector<float> states;
+  sensor.add_on_state_callback([&states](float state) { states.push_back(state); });
+  for (int i = 0; i < 10; i++)
+    sensor.publish_state(i);
+
+  // (x + 1) * 2, averaged over the last 4 values, sent for the 1st value and then every 2nd
+  const std::vector<float> expected = {2.0f, 4.0f, 7.0f, 11.0f, 15.0f};
+  EXPECT_EQ(states.size(), expected.size());
+  for (size_t i = 0; i < states.size() && i < expected.size(); i++)
+    EXPECT_NEAR(states[i], expected[i], 1e-5);
+  EXPECT_NEAR(sensor.get_raw_state(), 9.0f, 1e-5);
+}
+
+class TimerComponent : public Component {
+ public:
+  using Component::set_interval;
+  using Component::set_timeout;
+};
+
+TEST_CASE(component_timers) {
+  TimerComponent component;
+  std::vector<uint32_t> intervals, timeouts;
+  component.set_interval(100, [&intervals]() { intervals.push_back(millis()); });
+  component.set_timeout(250, [&timeouts]() { timeouts.push_back(millis()); });
+
+  for (int i = 0; i < 100; i++) {
+    component.loop_();
+    delay(10);
+  }
+  // the first interval runs right away, then every 100ms (with a random phase offset of less than 50ms)
+  EXPECT(intervals.size() >= 10);
+  EXPECT_EQ(intervals[0], 0u);
+  for (size_t i = 2; i < intervals.size(); i++)
+    EXPECT_EQ(intervals[i] - intervals[i - 1], 100u);
+  EXPECT_EQ(timeouts.size(), 1u);
+  // timeouts run in the first loop after more than 250ms have passed
+  EXPECT_EQ(timeouts[0], 260u);
+}
+
+class NamedComponent : public Component, public sensor::Sensor {
+ public:
+  NamedComponent() : sensor::Sensor("Outside Temperature") {}
+};
+
+TEST_CASE(component_name) {
+  // what Application::register_component() does
+  TimerComponent unnamed;
+  unnamed.set_component_nameable(component_nameable(&unnamed));
+  EXPECT(unnamed.get_component_name().empty());
+  NamedComponent named;
+  named.set_component_nameable(component_nameable(&named));
+  EXPECT(named.get_component_name() == "Outside Temperature");
+}
+
+/// An action that abandons every run, like a loop that is already run by another run of the script.
+class DropRunAction : public Action<NoArg> {
+ public:
+  void play(NoArg x) override {
+    this->drop_run_next(x);
+  }
+};
+
+TEST_CASE(script_while_drop_run) {
+  Script script;
+  Automation<NoArg> automation(&script);
+  int loops = 0;
+  auto *loop = new WhileAction<NoArg>({new LambdaCondition<NoArg>([&loops](NoArg) { return loops < 3; })});
+  loop->add_then({new LambdaAction<NoArg>([&loops](NoArg) { loops++; })});
+  auto *dropping = new WhileAction<NoArg>({new LambdaCondition<NoArg>([](NoArg) { return true; })});
+  dropping->add_then({new DropRunAction()});
+  automation.add_actions({loop, dropping});
+
+  script.execute();
+  EXPECT_EQ(loops, 3);
+  // the run dropped inside the second loop still reaches the end of the script
+  EXPECT(!script.is_running());
+  // and the loop isn't stuck, the next run gets to it again
+  loops = 0;
+  script.execute();
+  EXPECT_EQ(loops, 3);
+  EXPECT(!script.is_running());
+}
+
+TEST_CASE(host_gpio) {
+  GPIOPin input(5, INPUT);
+  input.setup();
+  EXPECT_EQ(int(host::get_pin_mode(5)), INPUT);
+  EXPECT(!input.digital_read());
+  host::set_pin_level(5, true);
+  EXPECT(input.digital_read());
+
+  GPIOPin output(40, OUTPUT, true);
+  output.digital_write(true);
+  EXPECT(!host::get_pin_level(40));
+  output.to_fast_gpio().digital_write(false);
+  EXPECT(host::get_pin_level(40));
+}
@@ -0,0 +1,111 @@
+// Tests of the DHT frame decoder with edge traces as the pin interrupt records them, and of a complete
+// capture through the simulated pin interrupt.
+
+#include "test.h"
+#include "esphomelib/sensor/dht_component.h"
+
+using namespace esphomelib;
+using namespace esphomelib::sensor;
+
+/// Build the edge timestamps of a frame: the response (80µs low, 80µs high), then for each bit 50µs low
+/// and 26µs (0) or 70µs (1) high, and the final 50µs low before the sensor releases the bus.
+static uint8_t make_trace(const uint8_t *data, uint16_t start, int jitter, uint16_t *edges) {
+  uint8_t count = 0;
+  uint16_t t = start;
+  edges[count++] = t;
+  t += 80;
+  edges[count++] = t;
+  t += 80;
+  for (uint8_t bit = 0; bit < 40; bit++) {
+    // a little deterministic jitter like interrupt latency causes
+    const int j = jitter * ((bit * 7) % 5 - 2) / 2;
+    edges[count++] = t;
+    t += 50 + j;
+    edges[count++] = t;
+    const bool one = (data[bit / 8] >> (7 - bit % 8)) & 1;
+    t += one ? 70 : 26;
+  }
+  edges[count++] = t;
+  t += 50;
+  edges[count++] = t;
+  return count;
+}
+
+TEST_CASE(dht_decode_frame) {
+  // 65.2% and 35.1°C
+  const uint8_t frame[5] = {0x02, 0x8C, 0x01, 0x5F, 0xEE};
+  uint16_t edges[DHT_MAX_EDGES];
+  uint8_t count = make_trace(frame, 1000, 0, edges);
+  EXPECT_EQ(int(count), int(DHT_MAX_EDGES));
+
+  uint8_t data[5];
+  EXPECT_EQ(int(DHTComponent::decode_edges(edges, count, data)), 40);
+  for (int i = 0; i < 5; i++)
+    EXPECT_EQ(int(data[i]), int(frame[i]));
+}
+
+TEST_CASE(dht_decode_jitter_and_wraparound) {
+  const uint8_t frame[5] = {0xFF, 0x00, 0xA5, 0x5A, 0xFE};
+  uint16_t edges[DHT_MAX_EDGES];
+  // the 16 bit timestamps wrap around in the middle of the frame
+  uint8_t count = make_trace(frame, 65000, 8, edges);
+
+  uint8_t data[5];
+  EXPECT_EQ(int(DHTComponent::decode_edges(edges, count, data)), 40);
+  for (int i = 0; i < 5; i++)
+    EXPECT_EQ(int(data[i]), int(frame[i]));
+}
+
+TEST_CASE(dht_decode_truncated) {
+  const uint8_t frame[5] = {0x02, 0x8C, 0x01, 0x5F, 0xEE};
+  uint16_t edges[DHT_MAX_EDGES];
+  make_trace(frame, 0, 0, edges);
+
+  uint8_t data[5];
+  // the frame stopped after the high phase of bit 9 started
+  EXPECT_EQ(int(DHTComponent::decode_edges(edges, 3 + 2 * 9 + 1, data)), 9);
+  EXPECT_EQ(int(DHTComponent::decode_edges(edges, 2, data)), 0);
+}
+
+/// Exposes the steps of a reading, which are normally run by update() and its timeouts.
+class TestDHT : public DHTComponent {
+ public:
+  TestDHT(GPIOPin *pin) : DHTComponent("Temperature", "Humidity", pin) {}
+  using DHTComponent::start_capture_;
+  using DHTComponent::finish_capture_;
+};
+
+static void drive(uint8_t pin, bool level, uint32_t after_us) {
+  delayMicroseconds(after_us);
+  host::set_pin_level(pin, level);
+}
+
+TEST_CASE(dht_capture) {
+  GPIOPin pin(4, INPUT);
+  TestDHT dht(&pin);
+  dht.set_dht_model(DHT_MODEL_DHT22);
+  dht.setup();
+
+  // the start pulse
+  pin.pin_mode(OUTPUT);
+  pin.digital_write(false);
+  delay(1);
+  dht.start_capture_();
+  // the pull-up raises the line after the release, this edge must not be recorded
+  drive(4, true, 2);
+
+  // 55.5% and 23.4°C
+  const uint8_t frame[5] = {0x02, 0x2B, 0x00, 0xEA, 0x17};
+  drive(4, false, 30);
+  drive(4, true, 80);
+  for (uint8_t bit = 0; bit < 40; bit++) {
+    drive(4, false, bit == 0 ? 80 : ((frame[(bit - 1) / 8] >> (7 - (bit - 1) % 8)) & 1 ? 70 : 26));
+    drive(4, true, 50);
+  }
+  drive(4, false, (frame[4] & 1) ? 70 : 26);
+  drive(4, true, 50);
+
+  dht.finish_capture_();
+  EXPECT_NEAR(dht.get_temperature_sensor()->get_state(), 23.4, 0.01);
+  EXPECT_NEAR(dht.get_humidity_sensor()->get_state(), 55.5, 0.01);
+}
@@ -0,0 +1,42 @@
+// Runs all registered tests, or only the ones whose name contains the first argument.
+
+#include <cstring>
+
+#include "test.h"
+#include "esphomelib/esphal.h"
+
+static TestCase *test_cases = nullptr;
+static TestCase **test_cases_end = &test_cases;
+static int test_failures = 0;
+
+TestCase::TestCase(const char *name, void (*func)()) : name(name), func(func), next(nullptr) {
+  // keep the registration order, so tests run in the order of the source files
+  *test_cases_end = this;
+  test_cases_end = &this->next;
+}
+
+void test_fail(const char *file, int line, const std::string &message) {
+  printf("  %s:%d: %s\n", file, line, message.c_str());
+  test_failures++;
+}
+
+int main(int argc, char **argv) {
+  const char *filter = argc > 1 ? argv[1] : nullptr;
+  int run = 0, failed = 0;
+  for (TestCase *test = test_cases; test != nullptr; test = test->next) {
+    if (filter != nullptr && strstr(test->name, filter) == nullptr)
+      continue;
+    esphomelib::host::reset();
+    int failures_before = test_failures;
+    test->func();
+    run++;
+    if (test_failures != failures_before) {
+      printf("FAIL %s\n", test->name);
+      failed++;
+    } else {
+      printf("ok   %s\n", test->name);
+    }
+  }
+  printf("%d of %d tests passed.\n", run - failed, run);
+  return failed == 0 && run != 0 ? 0 : 1;
+}
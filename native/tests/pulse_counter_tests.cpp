@@ -0,0 +1,79 @@
+// Tests of the pulse counter rate estimation: the period measurement over the last edges and the
+// counting of edges into the 64-bit total.
+
+#include "test.h"
+#include "esphomelib/sensor/pulse_counter.h"
+
+using namespace esphomelib;
+using namespace esphomelib::sensor;
+
+TEST_CASE(pulse_counter_period_rate) {
+  // one edge every 100ms = 600 pulses/min
+  const uint32_t times[] = {1000000, 1100000, 1200000, 1300000};
+  EXPECT_NEAR(PulseCounterBase::period_rate(times, 4, 1300000), 600.0f, 0.01f);
+  EXPECT_NEAR(PulseCounterBase::period_rate(times, 4, 1350000), 600.0f, 0.01f);
+  // only the average period counts, not the individual ones
+  const uint32_t uneven[] = {0, 50000, 250000, 300000};
+  EXPECT_NEAR(PulseCounterBase::period_rate(uneven, 4, 300000), 600.0f, 0.01f);
+}
+
+TEST_CASE(pulse_counter_period_rate_decays) {
+  const uint32_t times[] = {1000000, 1100000, 1200000};
+  // no edge for 400ms, the rate can be at most 150 pulses/min
+  EXPECT_NEAR(PulseCounterBase::period_rate(times, 3, 1600000), 150.0f, 0.01f);
+  EXPECT_NEAR(PulseCounterBase::period_rate(times, 3, 61200000), 1.0f, 0.001f);
+}
+
+TEST_CASE(pulse_counter_period_rate_edge_cases) {
+  const uint32_t times[] = {1000000, 1100000};
+  EXPECT_EQ(PulseCounterBase::period_rate(times, 0, 1000000), 0.0f);
+  EXPECT_EQ(PulseCounterBase::period_rate(times, 1, 1000000), 0.0f);
+  // two edges at the same time and no time since then
+  const uint32_t same[] = {5000, 5000};
+  EXPECT_EQ(PulseCounterBase::period_rate(same, 2, 5000), 0.0f);
+  // micros() wraps around after about 71 minutes
+  const uint32_t wrapping[] = {0xFFFF0000u, 0xFFFF0000u + 100000u, 0xFFFF0000u + 200000u};
+  EXPECT_NEAR(PulseCounterBase::period_rate(wrapping, 3, 0xFFFF0000u + 200000u), 600.0f, 0.01f);
+}
+
+class TestPulseCounter : public PulseCounterSensorComponent {
+ public:
+  TestPulseCounter(GPIOPin *pin) : PulseCounterSensorComponent("Pulses", pin, 1000) {}
+  using PulseCounterSensorComponent::read_edges_;
+
+  /// Simulate a pulse of the given length, starting in length µs.
+  void pulse(uint32_t length) {
+    delayMicroseconds(length);
+    host::set_pin_level(4, true);
+    this->gpio_intr();
+    delayMicroseconds(length);
+    host::set_pin_level(4, false);
+    this->gpio_intr();
+  }
+};
+
+TEST_CASE(pulse_counter_counting) {
+  GPIOPin pin(4, INPUT);
+  TestPulseCounter counter(&pin);
+  counter.set_period_samples(4);
+  counter.setup();
+
+  for (int i = 0; i < 10; i++)
+    counter.pulse(50000);
+  // only the rising edges count by default
+  EXPECT_EQ(counter.read_raw_value_(), 10);
+  EXPECT_EQ(counter.read_raw_value_(), 0);
+
+  uint32_t times[PULSE_COUNTER_MAX_PERIOD_SAMPLES];
+  const uint8_t count = counter.read_edges_(times);
+  EXPECT_EQ(count, 4);
+  EXPECT_EQ(times[3] - times[0], 300000u);
+  EXPECT_NEAR(PulseCounterBase::period_rate(times, count, micros()), 600.0f, 0.01f);
+
+  // pulses shorter than the filter are ignored
+  counter.set_filter_us(1000);
+  counter.pulse(10);
+  counter.pulse(2000);
+  EXPECT_EQ(counter.read_raw_value_(), 1);
+  EXPECT_EQ(counter.read_total_(), 11);
+}
@@ -0,0 +1,153 @@
+// Simulation of the stepper speed profile (Stepper::next_step_interval_()), step by step like the ESP32
+// stepper timer interrupt drives it.
+
+#include <vector>
+
+#include "test.h"
+#include "esphomelib/stepper/stepper.h"
+
+using namespace esphomelib;
+using namespace esphomelib::stepper;
+
+class SimStepper : public Stepper {
+ public:
+  SimStepper(float acceleration, float deceleration, float max_speed) {
+    this->set_acceleration(acceleration);
+    this->set_deceleration(deceleration);
+    this->set_max_speed(max_speed);
+  }
+
+  /** Run the profile until the stepper stops, like the timer interrupt: each step is made when its interval
+   * has passed, and the interval to the next step is computed right after.
+   *
+   * @param retarget_at Change the target to retarget_to after this many steps (-1 to never change it).
+   * @return The step intervals in µs, with the direction of each step in directions.
+   */
+  std::vector<uint32_t> run(int32_t target, int32_t retarget_at = -1, int32_t retarget_to = 0) {
+    this->set_target(target);
+    std::vector<uint32_t> intervals;
+    this->directions.clear();
+    uint32_t interval = this->next_step_interval_();
+    while (interval != 0 && intervals.size() < 1000000) {
+      intervals.push_back(interval);
+      this->current_position += this->direction_;
+      this->directions.push_back(this->direction_);
+      if (int32_t(intervals.size()) == retarget_at)
+        this->set_target(retarget_to);
+      interval = this->next_step_interval_();
+    }
+    return intervals;
+  }
+
+  std::vector<int8_t> directions;
+};
+
+static uint64_t total_us(const std::vector<uint32_t> &intervals) {
+  uint64_t total = 0;
+  // the first interval is from the start of the move to the first step
+  for (size_t i = 1; i < intervals.size(); i++)
+    total += intervals[i - 1];
+  return total;
+}
+
+TEST_CASE(stepper_step_count) {
+  SimStepper stepper(20000, 20000, 5000);
+  auto intervals = stepper.run(1000);
+  EXPECT_EQ(intervals.size(), 1000u);
+  EXPECT_EQ(int(stepper.current_position), 1000);
+  EXPECT(stepper.has_reached_target());
+
+  intervals = stepper.run(-234);
+  EXPECT_EQ(intervals.size(), 1234u);
+  EXPECT_EQ(int(stepper.current_position), -234);
+
+  // a single step
+  intervals = stepper.run(-233);
+  EXPECT_EQ(intervals.size(), 1u);
+  EXPECT_EQ(int(stepper.current_position), -233);
+}
+
+TEST_CASE(stepper_max_speed) {
+  SimStepper stepper(50000, 50000, 5000);
+  auto intervals = stepper.run(10000);
+  EXPECT_EQ(intervals.size(), 10000u);
+
+  uint32_t min_interval = UINT32_MAX;
+  size_t at_max_speed = 0;
+  for (uint32_t interval : intervals) {
+    min_interval = std::min(min_interval, interval);
+    if (interval == 200)
+      at_max_speed++;
+  }
+  // 5000 steps/s is a step every 200µs, never faster
+  EXPECT_EQ(min_interval, 200u);
+  // v^2 / (2a) = 250 steps to accelerate and to decelerate
+  EXPECT_NEAR(double(at_max_speed), 9500.0, 20.0);
+  // 0.1s to accelerate, 0.1s to decelerate and 9500 steps at 5000 steps/s
+  EXPECT_NEAR(double(total_us(intervals)), 2.1e6, 2.1e6 * 0.02);
+}
+
+TEST_CASE(stepper_ramp_symmetry) {
+  SimStepper stepper(20000, 20000, 2000);
+  auto intervals = stepper.run(1000);
+  EXPECT_EQ(intervals.size(), 1000u);
+
+  // With equal acceleration and deceleration, the ramp down mirrors the ramp up.
+  for (size_t i = 1; i < 100; i++) {
+    double up = intervals[i];
+    double down = intervals[intervals.size() - 1 - i];
+    EXPECT_NEAR(down / up, 1.0, 0.1);
+  }
+  // and the speed only changes monotonically on each ramp
+  for (size_t i = 1; i < 100; i++) {
+    EXPECT(intervals[i] <= intervals[i - 1]);
+    EXPECT(intervals[intervals.size() - i] >= intervals[intervals.size() - i - 1]);
+  }
+}
+
+TEST_CASE(stepper_slower_deceleration) {
+  SimStepper stepper(20000, 5000, 2000);
+  auto intervals = stepper.run(2000);
+  EXPECT_EQ(intervals.size(), 2000u);
+
+  size_t accel_steps = 0, decel_steps = 0;
+  while (intervals[accel_steps] > 500)
+    accel_steps++;
+  while (intervals[intervals.size() - 1 - decel_steps] > 500)
+    decel_steps++;
+  // a quarter of the deceleration takes four times the steps to slow down from the same speed
+  EXPECT_NEAR(double(decel_steps) / double(accel_steps), 4.0, 0.5);
+}
+
+TEST_CASE(stepper_reversal) {
+  SimStepper stepper(20000, 20000, 2000);
+  // Reverse at full speed, after 500 steps towards 1000
+  auto intervals = stepper.run(1000, 500, -500);
+  EXPECT_EQ(int(stepper.current_position), -500);
+
+  size_t reverse = 0;
+  while (reverse < stepper.directions.size() && stepper.directions[reverse] == 1)
+    reverse++;
+  EXPECT(reverse > 500);
+  EXPECT(reverse < stepper.directions.size());
+  // it slowed down to (almost) standstill before reversing: v^2 / (2a) = 100 steps to stop
+  EXPECT_NEAR(double(reverse), 600.0, 5.0);
+  EXPECT(intervals[reverse - 1] > 2000);
+  EXPECT(intervals[reverse] > 2000);
+  // every step was made in the final direction after that
+  for (size_t i = reverse; i < stepper.directions.size(); i++)
+    EXPECT_EQ(int(stepper.directions[i]), -1);
+  // 600 steps forward, 1100 back
+  EXPECT_EQ(intervals.size(), 1700u);
+}
+
+TEST_CASE(stepper_retarget_further) {
+  SimStepper stepper(20000, 20000, 2000);
+  // Move the target away while decelerating, it accelerates again instead of stopping
+  auto intervals = stepper.run(300, 250, 2000);
+  EXPECT_EQ(int(stepper.current_position), 2000);
+  EXPECT_EQ(intervals.size(), 2000u);
+  // it doesn't slow down any further after the target moved
+  for (size_t i = 250; i < 1000; i++)
+    EXPECT(intervals[i] <= intervals[i - 1]);
+}
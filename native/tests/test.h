@@ -0,0 +1,54 @@
+#ifndef ESPHOMELIB_NATIVE_TESTS_TEST_H
+#define ESPHOMELIB_NATIVE_TESTS_TEST_H
+
+// A minimal test framework for the native host target.
+//
+// TEST_CASE(name) { ... } registers a test, EXPECT*() record a failure and continue. Every test starts with
+// the simulated HAL reset (clock at 0, all pins low).
+
+#include <cmath>
+#include <cstdio>
+#include <sstream>
+#include <string>
+
+struct TestCase {
+  TestCase(const char *name, void (*func)());
+
+  const char *name;
+  void (*func)();
+  TestCase *next;
+};
+
+/// Record a failed expectation of the running test.
+void test_fail(const char *file, int line, const std::string &message);
+
+template<typename A, typename B>
+void test_expect_eq(const A &actual, const B &expected, const char *expr, const char *file, int line) {
+  if (actual == expected)
+    return;
+  std::ostringstream message;
+  message << expr << ": got " << actual << ", expected " << expected;
+  test_fail(file, line, message.str());
+}
+
+#define TEST_CASE(name) \
+  static void test_##name(); \
+  static TestCase test_case_##name(#name, test_##name); \
+  static void test_##name()
+
+#define EXPECT(cond) \
+  do { if (!(cond)) test_fail(__FILE__, __LINE__, "EXPECT(" #cond ")"); } while (false)
+
+#define EXPECT_EQ(actual, expected) test_expect_eq((actual), (expected), #actual, __FILE__, __LINE__)
+
+#define EXPECT_NEAR(actual, expected, tolerance) \
+  do { \
+    double test_actual_ = (actual), test_expected_ = (expected); \
+    if (!(std::fabs(test_actual_ - test_expected_) <= (tolerance))) { \
+      std::ostringstream test_message_; \
+      test_message_ << #actual << ": got " << test_actual_ << ", expected " << test_expected_ << " +- " << (tolerance); \
+      test_fail(__FILE__, __LINE__, test_message_.str()); \
+    } \
+  } while (false)
+
+#endif //ESPHOMELIB_NATIVE_TESTS_TEST_H
@@ -47,6 +47,9 @@ void APIBuffer::encode_bool(uint32_t field, bool value) {
 void APIBuffer::encode_string(uint32_t field, const std::string &value) {
   this->encode_string(field, value.data(), value.size());
 }
+void APIBuffer::encode_string(uint32_t field, const char *string) {
+  this->encode_string(field, string, strlen(string));
+}
 void APIBuffer::encode_string(uint32_t field, const char *string, size_t len) {
   if (len == 0)
     return;
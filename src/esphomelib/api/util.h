@@ -27,6 +27,7 @@ class APIBuffer {
   void encode_sint32(uint32_t field, int32_t value);
   void encode_bool(uint32_t field, bool value);
   void encode_string(uint32_t field, const std::string &value);
+  void encode_string(uint32_t field, const char *string);
   void encode_string(uint32_t field, const char *string, size_t len);
   void encode_fixed32(uint32_t field, uint32_t value);
   void encode_float(uint32_t field, float value);
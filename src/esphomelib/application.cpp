@@ -49,44 +49,134 @@ using namespace esphomelib::stepper;
 
 static const char *TAG = "application";
 
+/// Stable sort of components by descending priority, with the virtual priority getter called only once per component.
+template<typename F>
+static void sort_components_by_priority(std::vector<Component *>::iterator begin,
+                                        std::vector<Component *>::iterator end, F &&get_priority) {
+  std::vector<std::pair<float, Component *>> keyed;
+  keyed.reserve(end - begin);
+  for (auto it = begin; it != end; it++)
+    keyed.emplace_back(get_priority(*it), *it);
+  std::stable_sort(keyed.begin(), keyed.end(), [](const std::pair<float, Component *> &a,
+                                                  const std::pair<float, Component *> &b) {
+    return a.first > b.first;
+  });
+  for (auto &pair : keyed)
+    *begin++ = pair.second;
+}
+
+/// Whether setup() of this component still has to be called.
+static bool is_waiting_for_setup(Component *component) {
+  if (component->is_failed())
+    return false;
+  return (component->get_component_state() & COMPONENT_STATE_MASK) == COMPONENT_STATE_CONSTRUCTION;
+}
+
+void Application::setup_component_(uint32_t index) {
+  Component *component = this->components_[index];
+  ComponentSetupTiming &timing = this->setup_timeline_[index];
+  timing.component = component;
+  timing.start = millis();
+  const uint32_t start = micros();
+  {
+#ifdef USE_HEAP_TRACKER
+    HeapTrackerScope heap_scope(component->get_heap_stats());
+#endif
+    component->setup_();
+  }
+  timing.duration_us = micros() - start;
+}
+
 void Application::setup() {
   ESP_LOGI(TAG, "Running through setup()...");
   assert(this->application_state_ == COMPONENT_STATE_CONSTRUCTION && "setup() called twice.");
+  this->register_component(&global_action_scheduler);
+#ifdef USE_HEAP_TRACKER
+  heap_tracker_begin();
+#endif
   ESP_LOGV(TAG, "Sorting components by setup priority...");
-  std::stable_sort(this->components_.begin(), this->components_.end(), [](const Component *a, const Component *b) {
-    return a->get_actual_setup_priority() > b->get_actual_setup_priority();
+  sort_components_by_priority(this->components_.begin(), this->components_.end(), [](const Component *c) {
+    return c->get_actual_setup_priority();
   });
+  // All components are registered by now, don't keep the spare capacity of the vector around.
+  this->components_.shrink_to_fit();
 
-  for (uint32_t i = 0; i < this->components_.size(); i++) {
-    Component *component = this->components_[i];
-    if (component->is_failed())
-      continue;
+  // While components are still starting up, all components that are already set up are looped in this order.
+  std::vector<Component *> loop_order(this->components_);
+  sort_components_by_priority(loop_order.begin(), loop_order.end(), [](Component *c) {
+    return c->get_loop_priority();
+  });
+  this->setup_timeline_.clear();
+  this->setup_timeline_.resize(this->components_.size());
+
+  // Start connecting to WiFi once the buses and hardware components are set up, instead of after all components
+  // before it, so that slow sensor setups overlap with establishing the connection. Only with the default setup
+  // priority, set_setup_priority() or explicit dependencies on the WiFi component keep their plain meaning.
+  if (this->wifi_ != nullptr && !this->wifi_->has_setup_dependencies() &&
+      this->wifi_->get_actual_setup_priority() == this->wifi_->get_setup_priority()) {
+    for (Component *component : this->components_) {
+      if (component != this->wifi_ && component->get_actual_setup_priority() >= setup_priority::HARDWARE)
+        this->wifi_->add_setup_dependency(component);
+    }
+  }
 
-    component->setup_();
-    if (component->can_proceed())
-      continue;
+  while (true) {
+    // Components with declared dependencies first, they don't have to wait for the components before them.
+    for (uint32_t i = 0; i < this->components_.size(); i++) {
+      Component *component = this->components_[i];
+      if (component->has_setup_dependencies() && is_waiting_for_setup(component) &&
+          component->setup_dependencies_ready())
+        this->setup_component_(i);
+    }
 
-    std::stable_sort(this->components_.begin(), this->components_.begin() + i + 1, [](Component *a, Component *b) {
-      return a->get_loop_priority() > b->get_loop_priority();
-    });
-
-    do {
-      uint32_t new_global_state = STATUS_LED_WARNING;
-      for (uint32_t j = 0; j <= i; j++) {
-        if (!this->components_[j]->is_failed()) {
-          this->components_[j]->loop_();
-        }
-        new_global_state |= this->components_[j]->get_component_state();
-        global_state |= new_global_state;
+    // All other components are set up in order, each waiting until the components before it can proceed.
+    // A component that is still waiting for its declared dependencies doesn't hold up the ones after it (they
+    // may be what it's waiting for), once it's set up it's waited for like any other component.
+    bool blocked = false;
+    bool done = true;
+    for (uint32_t i = 0; i < this->components_.size(); i++) {
+      Component *component = this->components_[i];
+      if (!blocked && !component->has_setup_dependencies() && is_waiting_for_setup(component))
+        this->setup_component_(i);
+
+      if (component->is_failed())
+        continue;
+      if (is_waiting_for_setup(component) || !component->can_proceed()) {
+        done = false;
+        if (!component->has_setup_dependencies() || !is_waiting_for_setup(component))
+          blocked = true;
+      } else if (this->setup_timeline_[i].ready == 0) {
+        this->setup_timeline_[i].ready = std::max(millis(), uint32_t(1));
       }
-      global_state = new_global_state;
-      yield();
-    } while (!component->can_proceed());
+    }
+    if (done)
+      break;
+
+    uint32_t new_global_state = STATUS_LED_WARNING;
+    for (Component *component : loop_order) {
+      if (is_waiting_for_setup(component))
+        continue;
+      if (!component->is_failed()) {
+#ifdef USE_HEAP_TRACKER
+        HeapTrackerScope heap_scope(component->get_heap_stats());
+#endif
+        component->loop_();
+      }
+      new_global_state |= component->get_component_state();
+      global_state |= new_global_state;
+    }
+    global_state = new_global_state;
+    yield();
   }
 
+  this->components_ = loop_order;
+  std::stable_sort(this->setup_timeline_.begin(), this->setup_timeline_.end(),
+                   [](const ComponentSetupTiming &a, const ComponentSetupTiming &b) {
+    return a.start < b.start;
+  });
   this->application_state_ = COMPONENT_STATE_SETUP;
 
-  ESP_LOGI(TAG, "setup() finished successfully!");
+  ESP_LOGI(TAG, "setup() finished successfully after %ums!", millis());
   this->dump_config();
 }
 
@@ -101,10 +191,92 @@ void Application::dump_config() {
     Component *component = this->components_[i];
     component->dump_config();
   }
+  this->dump_setup_timeline_();
+}
+void Application::dump_setup_timeline_() {
+  ESP_LOGCONFIG(TAG, "Boot timeline (component numbers in the order of the config dump):");
+  for (auto &timing : this->setup_timeline_) {
+    if (timing.component == nullptr)
+      continue;
+    uint32_t index = std::find(this->components_.begin(), this->components_.end(), timing.component) -
+        this->components_.begin();
+    const char *name = timing.component->get_component_name().c_str();
+    if (timing.ready == 0) {
+      ESP_LOGCONFIG(TAG, "  Component %u %s: setup at %ums took %uus, failed", index, name, timing.start,
+                    timing.duration_us);
+    } else {
+      ESP_LOGCONFIG(TAG, "  Component %u %s: setup at %ums took %uus, ready at %ums", index, name, timing.start,
+                    timing.duration_us, timing.ready);
+    }
+  }
+}
+const std::vector<ComponentSetupTiming> &Application::get_setup_timeline() const {
+  return this->setup_timeline_;
+}
+
+#ifdef ARDUINO_ARCH_ESP8266
+/// The software watchdog of the ESP8266 resets after about 3.2s without a feed.
+static const uint32_t WATCHDOG_TIMEOUT_US = 3200000UL;
+#endif
+#ifdef ARDUINO_ARCH_ESP32
+#ifdef CONFIG_TASK_WDT_TIMEOUT_S
+static const uint32_t WATCHDOG_TIMEOUT_US = CONFIG_TASK_WDT_TIMEOUT_S * 1000000UL;
+#else
+static const uint32_t WATCHDOG_TIMEOUT_US = 5000000UL;
+#endif
+#endif
+
+uint32_t LoopStats::bucket_upper_us(uint8_t bucket) {
+  if (bucket >= LOOP_STATS_BUCKETS - 1)
+    return UINT32_MAX;
+  return 64UL << bucket;
+}
+uint32_t LoopStats::percentile_us(const uint32_t *histogram, float fraction) const {
+  uint32_t total = 0;
+  for (uint8_t i = 0; i < LOOP_STATS_BUCKETS; i++)
+    total += histogram[i];
+  if (total == 0)
+    return 0;
+
+  const uint32_t wanted = std::max(uint32_t(1), uint32_t(ceilf(total * fraction)));
+  uint32_t sum = 0;
+  for (uint8_t i = 0; i < LOOP_STATS_BUCKETS; i++) {
+    sum += histogram[i];
+    if (sum >= wanted)
+      return bucket_upper_us(i);
+  }
+  return UINT32_MAX;
+}
+uint32_t LoopStats::min_watchdog_margin_us() const {
+  if (this->longest_unfed_us >= WATCHDOG_TIMEOUT_US)
+    return 0;
+  return WATCHDOG_TIMEOUT_US - this->longest_unfed_us;
+}
+const LoopStats &Application::get_loop_stats() const {
+  return this->loop_stats_;
+}
+void Application::reset_loop_stats() {
+  this->loop_stats_ = LoopStats();
 }
 void Application::schedule_dump_config() {
   this->dump_config_scheduled_ = true;
 }
+#ifdef USE_HEAP_TRACKER
+void Application::dump_heap_stats() {
+  ESP_LOGD(TAG, "Heap: free=%u largest_block=%u fragmentation=%.0f%% allocations=%u",
+           ESP.getFreeHeap(), heap_largest_free_block(), heap_fragmentation(), heap_tracker_total_allocations());
+  ESP_LOGD(TAG, "  Other: live=%d peak=%d allocations=%u", heap_tracker_other.live_bytes,
+           heap_tracker_other.peak_bytes, heap_tracker_other.allocations);
+  for (uint32_t i = 0; i < this->components_.size(); i++) {
+    Component *component = this->components_[i];
+    HeapStats *stats = component->get_heap_stats();
+    if (stats->allocations == 0)
+      continue;
+    ESP_LOGD(TAG, "  Component %u %s: live=%d peak=%d allocations=%u", i, component->get_component_name().c_str(),
+             stats->live_bytes, stats->peak_bytes, stats->allocations);
+  }
+}
+#endif
 
 void HOT Application::loop() {
   assert(this->application_state_ >= COMPONENT_STATE_SETUP && "Did you forget to call setup()?");
@@ -115,17 +287,43 @@ void HOT Application::loop() {
     this->application_state_ = COMPONENT_STATE_LOOP;
   }
 
+  LoopStats &stats = this->loop_stats_;
+  // The watchdog was fed when the previous iteration yielded
+  const uint32_t start = micros();
+  uint32_t last = start;
+  uint32_t last_feed = start;
   uint32_t new_global_state = 0;
-  for (Component *component : this->components_) {
+  for (uint32_t i = 0; i < this->components_.size(); i++) {
+    Component *component = this->components_[i];
     if (!component->is_failed()) {
+#ifdef USE_HEAP_TRACKER
+      HeapTrackerScope heap_scope(component->get_heap_stats());
+#endif
       component->loop_();
     }
     new_global_state |= component->get_component_state();
     global_state |= new_global_state;
-    feed_wdt();
+
+    const uint32_t now = micros();
+    if (now - last > stats.longest_stall_us) {
+      stats.longest_stall_us = now - last;
+      stats.longest_stall_component = i;
+    }
+    last = now;
+    if (feed_wdt()) {
+      stats.longest_unfed_us = std::max(stats.longest_unfed_us, now - last_feed);
+      last_feed = now;
+    }
   }
   global_state = new_global_state;
 
+  stats.longest_unfed_us = std::max(stats.longest_unfed_us, last - last_feed);
+  stats.duration[LoopStats::bucket_for(last - start)]++;
+  if (stats.iterations != 0)
+    stats.interval[LoopStats::bucket_for(start - this->last_loop_start_us_)]++;
+  this->last_loop_start_us_ = start;
+  stats.iterations++;
+
   const uint32_t now = millis();
   if (HighFrequencyLoopRequester::is_high_frequency()) {
     yield();
@@ -212,6 +410,18 @@ MQTTBinarySensorComponent *Application::register_binary_sensor(binary_sensor::Bi
     ret = this->register_component(new MQTTBinarySensorComponent(binary_sensor));
   return ret;
 }
+binary_sensor::DelayedOnFilter *Application::register_component(binary_sensor::DelayedOnFilter *c) {
+  return c;
+}
+binary_sensor::DelayedOffFilter *Application::register_component(binary_sensor::DelayedOffFilter *c) {
+  return c;
+}
+binary_sensor::HeartbeatFilter *Application::register_component(binary_sensor::HeartbeatFilter *c) {
+  return c;
+}
+binary_sensor::MultiClickTrigger *Application::register_component(binary_sensor::MultiClickTrigger *c) {
+  return c;
+}
 #endif
 
 #ifdef USE_GPIO_BINARY_SENSOR
@@ -1023,6 +1233,17 @@ Application::MakeUptimeSensor Application::make_uptime_sensor(const std::string
 }
 #endif
 
+#ifdef USE_HEAP_SENSOR
+Application::MakeHeapSensor Application::make_heap_sensor(const std::string &name, uint32_t update_interval) {
+  auto *heap = this->register_component(new HeapSensor(name, update_interval));
+
+  return MakeHeapSensor{
+      .heap = heap,
+      .mqtt = this->register_sensor(heap),
+  };
+}
+#endif
+
 #ifdef USE_INA219
 sensor::INA219Component *Application::make_ina219(float shunt_resistance_ohm,
                                                   float max_current_a,
@@ -1246,6 +1467,17 @@ Application::MakeVersionTextSensor Application::make_version_text_sensor(const s
 }
 #endif
 
+#ifdef USE_LOOP_STATS_TEXT_SENSOR
+Application::MakeLoopStatsTextSensor Application::make_loop_stats_text_sensor(const std::string &name,
+                                                                              uint32_t update_interval) {
+  auto *sensor = this->register_component(new LoopStatsTextSensor(name, update_interval));
+  return MakeLoopStatsTextSensor {
+      .sensor = sensor,
+      .mqtt = this->register_text_sensor(sensor),
+  };
+}
+#endif
+
 #ifdef USE_MQTT_SUBSCRIBE_SENSOR
 Application::MakeMQTTSubscribeSensor Application::make_mqtt_subscribe_sensor(const std::string &name, std::string topic) {
   auto *sensor = this->register_component(new sensor::MQTTSubscribeSensor(name, std::move(topic)));
@@ -92,6 +92,7 @@
 #include "esphomelib/sensor/filter.h"
 #include "esphomelib/sensor/hdc1080_component.h"
 #include "esphomelib/sensor/hlw8012.h"
+#include "esphomelib/sensor/heap_sensor.h"
 #include "esphomelib/sensor/hmc5883l.h"
 #include "esphomelib/sensor/homeassistant_sensor.h"
 #include "esphomelib/sensor/htu21d_component.h"
@@ -135,12 +136,55 @@
 #include "esphomelib/text_sensor/template_text_sensor.h"
 #include "esphomelib/text_sensor/text_sensor.h"
 #include "esphomelib/text_sensor/version_text_sensor.h"
+#include "esphomelib/text_sensor/loop_stats_text_sensor.h"
 #include "esphomelib/time/rtc_component.h"
 #include "esphomelib/time/sntp_component.h"
 #include "esphomelib/time/homeassistant_time.h"
 
 ESPHOMELIB_NAMESPACE_BEGIN
 
+/// When and for how long a component was set up in Application::setup().
+struct ComponentSetupTiming {
+  Component *component{nullptr}; ///< nullptr if the component had already failed before setup.
+  uint32_t start{0}; ///< millis() when setup() was called.
+  uint32_t duration_us{0}; ///< How long setup() took in µs.
+  uint32_t ready{0}; ///< millis() when the component could proceed, 0 if it failed.
+};
+
+/// The number of buckets of the LoopStats histograms.
+static const uint8_t LOOP_STATS_BUCKETS = 16;
+
+/** Loop latency statistics collected by Application::loop().
+ *
+ * Both histograms are log2-bucketed: bucket 0 counts samples below 64µs, bucket i samples in
+ * [32µs << i, 64µs << i) and the last bucket everything from about one second upwards.
+ */
+struct LoopStats {
+  uint32_t duration[LOOP_STATS_BUCKETS]{}; ///< How long all component loop()s of one iteration took.
+  uint32_t interval[LOOP_STATS_BUCKETS]{}; ///< Start to start time of two iterations, including the loop delay.
+  uint32_t iterations{0};
+  uint32_t longest_stall_us{0}; ///< The longest single component loop().
+  int32_t longest_stall_component{-1}; ///< Its index in the order of the config dump, -1 if nothing ran yet.
+  /// The longest time the watchdog went unfed in Application::loop(), feeds inside components are not seen.
+  uint32_t longest_unfed_us{0};
+
+  static uint8_t bucket_for(uint32_t us) {
+    us >>= 6;
+    if (us == 0)
+      return 0;
+    uint8_t bucket = 32 - __builtin_clz(us);
+    return bucket < LOOP_STATS_BUCKETS ? bucket : LOOP_STATS_BUCKETS - 1;
+  }
+  /// The exclusive upper bound of a bucket in µs, UINT32_MAX for the last one.
+  static uint32_t bucket_upper_us(uint8_t bucket);
+
+  /// The upper bound of the bucket below which the given fraction (0-1) of the samples of a histogram fall.
+  uint32_t percentile_us(const uint32_t *histogram, float fraction) const;
+
+  /// How close the watchdog came to firing, in µs.
+  uint32_t min_watchdog_margin_us() const;
+};
+
 /// This is the class that combines all components.
 class Application {
  public:
@@ -890,6 +934,15 @@ class Application {
   MakeUptimeSensor make_uptime_sensor(const std::string &name, uint32_t update_interval = 15000);
 #endif
 
+#ifdef USE_HEAP_SENSOR
+  struct MakeHeapSensor {
+    sensor::HeapSensor *heap;
+    sensor::MQTTSensorComponent *mqtt;
+  };
+
+  MakeHeapSensor make_heap_sensor(const std::string &name, uint32_t update_interval = 60000);
+#endif
+
 #ifdef USE_INA219
   sensor::INA219Component *make_ina219(float shunt_resistance_ohm, float max_current_a, float max_voltage_v,
                                        uint8_t address = 0x40, uint32_t update_interval = 15000);
@@ -990,6 +1043,15 @@ class Application {
   MakeVersionTextSensor make_version_text_sensor(const std::string &name);
 #endif
 
+#ifdef USE_LOOP_STATS_TEXT_SENSOR
+  struct MakeLoopStatsTextSensor {
+    text_sensor::LoopStatsTextSensor *sensor;
+    text_sensor::MQTTTextSensor *mqtt;
+  };
+
+  MakeLoopStatsTextSensor make_loop_stats_text_sensor(const std::string &name, uint32_t update_interval = 60000);
+#endif
+
 #ifdef USE_TEMPLATE_TEXT_SENSOR
   struct MakeTemplateTextSensor {
     text_sensor::TemplateTextSensor *template_;
@@ -1371,6 +1433,18 @@ class Application {
   template<class C>
   C *register_component(C *c);
 
+  /// DelayActions are no longer components (they're run by the shared ActionScheduler), this is a no-op.
+  template<typename T>
+  DelayAction<T> *register_component(DelayAction<T> *c);
+
+#ifdef USE_BINARY_SENSOR
+  /// These binary sensor filters and triggers are run by the shared ActionScheduler, registering them is a no-op.
+  binary_sensor::DelayedOnFilter *register_component(binary_sensor::DelayedOnFilter *c);
+  binary_sensor::DelayedOffFilter *register_component(binary_sensor::DelayedOffFilter *c);
+  binary_sensor::HeartbeatFilter *register_component(binary_sensor::HeartbeatFilter *c);
+  binary_sensor::MultiClickTrigger *register_component(binary_sensor::MultiClickTrigger *c);
+#endif
+
   template<class C>
   C *register_controller(C *c);
 
@@ -1421,10 +1495,25 @@ class Application {
   void dump_config();
   void schedule_dump_config();
 
+  /// The setup timing of all components, in the order they were set up.
+  const std::vector<ComponentSetupTiming> &get_setup_timeline() const;
+
+  /// The loop latency statistics since boot or the last reset_loop_stats().
+  const LoopStats &get_loop_stats() const;
+  void reset_loop_stats();
+
+#ifdef USE_HEAP_TRACKER
+  /// Log the allocation statistics of all components, in the order of the config dump.
+  void dump_heap_stats();
+#endif
+
  protected:
   void register_component_(Component *comp);
+  void setup_component_(uint32_t index);
+  void dump_setup_timeline_();
 
   std::vector<Component *> components_{};
+  std::vector<ComponentSetupTiming> setup_timeline_{};
   std::vector<Controller *> controllers_{};
   mqtt::MQTTClientComponent *mqtt_client_{nullptr};
   WiFiComponent *wifi_{nullptr};
@@ -1434,6 +1523,8 @@ class Application {
   uint32_t application_state_{COMPONENT_STATE_CONSTRUCTION};
   uint32_t last_loop_{0};
   uint32_t loop_interval_{16};
+  uint32_t last_loop_start_us_{0};
+  LoopStats loop_stats_{};
 #ifdef USE_I2C
   I2CComponent *i2c_{nullptr};
 #endif
@@ -1447,6 +1538,13 @@ template<class C>
 C *Application::register_component(C *c) {
   static_assert(std::is_base_of<Component, C>::value, "Only Component subclasses can be registered");
   this->register_component_((Component *) c);
+  if (c != nullptr)
+    c->set_component_nameable(component_nameable(c));
+  return c;
+}
+
+template<typename T>
+DelayAction<T> *Application::register_component(DelayAction<T> *c) {
   return c;
 }
 
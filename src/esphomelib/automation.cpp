@@ -3,6 +3,8 @@
 
 ESPHOMELIB_NAMESPACE_BEGIN
 
+static const char *TAG = "automation";
+
 void Trigger<NoArg>::trigger() {
   this->parent_->process_trigger_(false);
 }
@@ -71,11 +73,158 @@ void RangeCondition::set_max(float max) {
   this->max_ = max;
 }
 
+bool ScheduledTask::is_scheduled() const {
+  return this->task_scheduled_;
+}
+
+void ActionScheduler::schedule(ScheduledTask *task, uint32_t delay) {
+  task->task_start_ = millis();
+  task->task_delay_ = delay;
+  task->task_scheduled_ = true;
+  if (task->task_in_list_)
+    return;
+
+  task->task_in_list_ = true;
+  ScheduledTask **list = this->running_ ? &this->pending_ : &this->tasks_;
+  task->task_next_ = *list;
+  *list = task;
+}
+void ActionScheduler::cancel(ScheduledTask *task) {
+  // Removed from the list lazily in loop().
+  task->task_scheduled_ = false;
+}
+void ActionScheduler::loop() {
+  this->running_ = true;
+  const uint32_t now = millis();
+  ScheduledTask **ptr = &this->tasks_;
+  while (*ptr != nullptr) {
+    ScheduledTask *task = *ptr;
+    if (task->task_scheduled_ && now - task->task_start_ < task->task_delay_) {
+      ptr = &task->task_next_;
+      continue;
+    }
+
+    *ptr = task->task_next_;
+    task->task_in_list_ = false;
+    if (task->task_scheduled_) {
+      task->task_scheduled_ = false;
+      task->run_task();
+    }
+  }
+  this->running_ = false;
+
+  while (this->pending_ != nullptr) {
+    ScheduledTask *task = this->pending_;
+    this->pending_ = task->task_next_;
+    task->task_next_ = this->tasks_;
+    this->tasks_ = task;
+  }
+}
+float ActionScheduler::get_setup_priority() const {
+  return setup_priority::HARDWARE;
+}
+
+ActionScheduler global_action_scheduler;
+
 void Script::execute() {
-  this->trigger();
+  this->install_hooks_();
+  if (this->running_ == 0 && !this->is_scheduled()) {
+    this->start_run_();
+    return;
+  }
+
+  switch (this->mode_) {
+    case SCRIPT_MODE_SINGLE:
+      ESP_LOGD(TAG, "Script is already running, ignoring execution.");
+      break;
+    case SCRIPT_MODE_RESTART:
+      this->stop();
+      this->start_run_();
+      break;
+    case SCRIPT_MODE_QUEUED:
+      if (this->max_runs_ != 0 && this->queued_ >= this->max_runs_) {
+        ESP_LOGW(TAG, "Script queue is full (%u), dropping execution.", this->queued_);
+        break;
+      }
+      this->queued_++;
+      break;
+    case SCRIPT_MODE_PARALLEL:
+      if (this->max_runs_ != 0 && this->running_ >= this->max_runs_) {
+        ESP_LOGW(TAG, "Script already has %u runs in progress, ignoring execution.", this->running_);
+        break;
+      }
+      this->start_run_();
+      break;
+  }
 }
 void Script::stop() {
+  global_action_scheduler.cancel(this);
+  this->queued_ = 0;
   this->parent_->stop();
+  this->running_ = 0;
+}
+void Script::set_mode(ScriptMode mode) {
+  this->mode_ = mode;
+}
+void Script::set_max_runs(uint8_t max_runs) {
+  this->max_runs_ = max_runs;
+}
+bool Script::is_running() const {
+  return this->running_ != 0;
+}
+uint8_t Script::get_running_count() const {
+  return this->running_;
+}
+uint8_t Script::get_queue_depth() const {
+  return this->queued_;
+}
+void Script::run_task() {
+  if (this->running_ != 0) {
+    // A run was started in between, wait for it to finish.
+    this->queued_++;
+    return;
+  }
+  this->start_run_();
+}
+void Script::install_hooks_() {
+  if (this->hooks_installed_)
+    return;
+  // Scripts are only executed after setup, so all of their actions are registered by now.
+  this->parent_->add_action(new ScriptRunHook(this, false));
+  this->parent_->add_action_front(new ScriptRunHook(this, true));
+  this->hooks_installed_ = true;
+}
+void Script::start_run_() {
+  // running_ is incremented by the start hook, so runs blocked by automation conditions aren't counted.
+  // It's decremented by the end hook, which is also reached by runs that an action dropped (see drop_run()).
+  this->trigger();
+}
+void Script::on_run_finished_() {
+  if (this->running_ != 0)
+    this->running_--;
+  if (this->mode_ == SCRIPT_MODE_QUEUED && this->queued_ != 0 && this->running_ == 0) {
+    this->queued_--;
+    // Start the next run from the scheduler so back-to-back runs don't recurse.
+    global_action_scheduler.schedule(this, 0);
+  }
+}
+
+ScriptRunHook::ScriptRunHook(Script *script, bool start)
+    : script_(script), start_(start) {
+
+}
+void ScriptRunHook::play(NoArg x) {
+  if (this->start_) {
+    this->script_->running_++;
+  } else {
+    this->script_->on_run_finished_();
+  }
+  this->play_next(x);
+}
+void ScriptRunHook::drop_run(NoArg x) {
+  if (!this->start_)
+    this->script_->on_run_finished_();
+  this->drop_run_next(x);
 }
 
 ESPHOMELIB_NAMESPACE_END
@@ -2,22 +2,147 @@
 #define ESPHOMELIB_AUTOMATION_H
 
 #include <vector>
+#include <type_traits>
 #include "esphomelib/espmath.h"
 #include "esphomelib/component.h"
 #include "esphomelib/helpers.h"
 #include "esphomelib/defines.h"
 #include "esphomelib/esppreferences.h"
+#include "esphomelib/log.h"
 
 ESPHOMELIB_NAMESPACE_BEGIN
 
 using NoArg = bool;
 
+/// The number of runs a single DelayAction can wait for without allocating, more runs get heap-allocated slots.
+static const uint8_t DELAY_ACTION_MAX_PENDING = 4;
+
+/** A continuation of an automation that should run later, for example after a delay.
+ *
+ * Tasks are linked intrusively in the ActionScheduler, so scheduling one never allocates.
+ */
+class ScheduledTask {
+ public:
+  virtual void run_task() = 0;
+
+  bool is_scheduled() const;
+
+ protected:
+  friend class ActionScheduler;
+
+  uint32_t task_start_{0};
+  uint32_t task_delay_{0};
+  bool task_scheduled_{false};
+  bool task_in_list_{false};
+  ScheduledTask *task_next_{nullptr};
+};
+
+/** The scheduler for all automation delays.
+ *
+ * A single component runs the timers of all ScheduledTasks, instead of every DelayAction
+ * being a component with its own timeouts.
+ */
+class ActionScheduler : public Component {
+ public:
+  /// Run task once delay ms have passed. If the task is already scheduled, it's re-scheduled.
+  void schedule(ScheduledTask *task, uint32_t delay);
+  void cancel(ScheduledTask *task);
+
+  void loop() override;
+  float get_setup_priority() const override;
+
+ protected:
+  ScheduledTask *tasks_{nullptr};
+  /// Tasks scheduled while loop() is running, they're only checked in the next loop().
+  ScheduledTask *pending_{nullptr};
+  bool running_{false};
+};
+
+extern ActionScheduler global_action_scheduler;
+
+/** A ScheduledTask that calls a member function of its owner.
+ *
+ * Used for classes that need a fixed set of timers, without being a component and without
+ * allocating a named timeout every time one is started.
+ */
+template<typename C>
+class ScheduledCallback : public ScheduledTask {
+ public:
+  ScheduledCallback(C *owner, void (C::*callback)());
+
+  /// Run the callback in delay ms, re-scheduling it if it's already pending.
+  void schedule(uint32_t delay);
+  void cancel();
+
+  void run_task() override;
+
+ protected:
+  C *owner_;
+  void (C::*callback_)();
+};
+
+template<typename C>
+ScheduledCallback<C>::ScheduledCallback(C *owner, void (C::*callback)())
+    : owner_(owner), callback_(callback) {
+
+}
+template<typename C>
+void ScheduledCallback<C>::schedule(uint32_t delay) {
+  global_action_scheduler.schedule(this, delay);
+}
+template<typename C>
+void ScheduledCallback<C>::cancel() {
+  global_action_scheduler.cancel(this);
+}
+template<typename C>
+void ScheduledCallback<C>::run_task() {
+  (this->owner_->*this->callback_)();
+}
+
+/// Storage for a trigger argument while an action is waiting. References are stored as pointers.
+template<typename T>
+struct StoredArg {
+  void set(T x) { this->value = x; }
+  T get() { return this->value; }
+
+  T value{};
+};
+
+template<typename T>
+struct StoredArg<T &> {
+  void set(T &x) { this->ptr = &x; }
+  T &get() { return *this->ptr; }
+
+  T *ptr{nullptr};
+};
+
 template<typename T>
 class Condition {
  public:
   virtual bool check(T x) = 0;
 };
 
+/** A condition that only depends on the state of components, not on the trigger argument.
+ *
+ * Subclasses subscribe to their inputs and recompute the result with publish_result_() only when
+ * one of them changes. check() then just returns the cached result, and result changes can be
+ * observed with add_on_change_callback().
+ */
+template<typename T>
+class StateCondition : public Condition<T> {
+ public:
+  bool check(T x) override;
+
+  /// Add a callback that's called with the new result every time it changes.
+  void add_on_change_callback(std::function<void(bool)> &&callback);
+
+ protected:
+  void publish_result_(bool result);
+
+  bool result_{false};
+  CallbackManager<void(bool)> change_callback_{};
+};
+
 template<typename T>
 class AndCondition : public Condition<T> {
  public:
@@ -117,17 +242,59 @@ class ScriptStopAction;
 template<typename T>
 class ScriptStopAction;
 
-class Script : public Trigger<NoArg> {
+class ScriptRunHook;
+
+/// How a script handles being executed while a previous run is still in progress.
+enum ScriptMode {
+  SCRIPT_MODE_SINGLE = 0,  ///< Ignore the new execution.
+  SCRIPT_MODE_RESTART,  ///< Stop the running instance and start again.
+  SCRIPT_MODE_QUEUED,  ///< Start the new run once the previous one finished, up to max_runs waiting.
+  SCRIPT_MODE_PARALLEL,  ///< Run alongside the previous runs, up to max_runs at the same time (0 = no limit).
+};
+
+class Script : public Trigger<NoArg>, public ScheduledTask {
  public:
   void execute();
 
+  /// Stop all running instances and clear the queue.
   void stop();
 
+  void set_mode(ScriptMode mode);
+  /** Set the limit for the execution mode.
+   *
+   * For SCRIPT_MODE_QUEUED this is the maximum queue depth, for SCRIPT_MODE_PARALLEL the maximum
+   * number of runs at the same time.
+   */
+  void set_max_runs(uint8_t max_runs);
+
+  bool is_running() const;
+  /// The number of runs that are currently in progress, for example waiting in a delay.
+  uint8_t get_running_count() const;
+  /// The number of executions waiting for the running instance to finish (SCRIPT_MODE_QUEUED only).
+  uint8_t get_queue_depth() const;
+
+  /// Internal method: start the next queued run.
+  void run_task() override;
+
   template<typename T>
   ScriptExecuteAction<T> *make_execute_action();
 
   template<typename T>
   ScriptStopAction<T> *make_stop_action();
+
+ protected:
+  friend ScriptRunHook;
+
+  /// Add the actions that track the start and end of every run, once all actions are registered.
+  void install_hooks_();
+  void start_run_();
+  void on_run_finished_();
+
+  ScriptMode mode_{SCRIPT_MODE_PARALLEL};
+  uint8_t max_runs_{0};
+  uint8_t running_{0};
+  uint8_t queued_{0};
+  bool hooks_installed_{false};
 };
 
 template<typename T>
@@ -140,14 +307,25 @@ class Action {
   void play_next(T x);
   virtual void stop();
   void stop_next();
+  /** Abandon a run at this action: the remaining actions are skipped, but passed the drop so that the
+   * end of the action list (for example a script's run tracking) still learns that the run is over.
+   */
+  virtual void drop_run(T x);
+  void drop_run_next(T x);
  protected:
   friend ActionList<T>;
 
   Action<T> *next_ = nullptr;
 };
 
+/** Wait for some time before playing the next action.
+ *
+ * Each DelayAction has DELAY_ACTION_MAX_PENDING preallocated slots, one for every run that is waiting
+ * at the same time, and their timers are run by the shared global_action_scheduler. If more runs overlap,
+ * additional slots are allocated on the heap and kept for later runs.
+ */
 template<typename T>
-class DelayAction : public Action<T>, public Component {
+class DelayAction : public Action<T> {
  public:
   explicit DelayAction();
 
@@ -156,9 +334,30 @@ class DelayAction : public Action<T>, public Component {
   void stop() override;
 
   void play(T x) override;
-  float get_setup_priority() const override;
+
  protected:
+  class Slot : public ScheduledTask {
+   public:
+    void run_task() override;
+
+    DelayAction<T> *parent_{nullptr};
+    StoredArg<T> x_;
+  };
+
   TemplatableValue<uint32_t, T> delay_{0};
+  Slot slots_[DELAY_ACTION_MAX_PENDING];
+  std::vector<Slot *> extra_slots_{};
+};
+
+/// Internal action that continues playing after another action, used to join nested action lists.
+template<typename T>
+class ContinuationAction : public Action<T> {
+ public:
+  explicit ContinuationAction(Action<T> *parent);
+  void play(T x) override;
+  void drop_run(T x) override;
+ protected:
+  Action<T> *parent_;
 };
 
 template<typename T>
@@ -201,6 +400,17 @@ class WhileAction : public Action<T> {
   void stop() override;
 
  protected:
+  /// The last action of then_: checks the conditions again, or ends the loop when a run was dropped inside it.
+  class LoopAction : public Action<T> {
+   public:
+    explicit LoopAction(WhileAction<T> *parent);
+    void play(T x) override;
+    void drop_run(T x) override;
+
+   protected:
+    WhileAction<T> *parent_;
+  };
+
   std::vector<Condition<T> *> conditions_;
   ActionList<T> then_;
   bool is_running_{false};
@@ -235,10 +445,23 @@ class ScriptStopAction : public Action<T> {
   Script *script_;
 };
 
+/// Marks the start or the end of a script run, inserted at both ends of the script's action list.
+class ScriptRunHook : public Action<NoArg> {
+ public:
+  ScriptRunHook(Script *script, bool start);
+
+  void play(NoArg x) override;
+  void drop_run(NoArg x) override;
+ protected:
+  Script *script_;
+  bool start_;
+};
+
 template<typename T>
 class ActionList {
  public:
   Action<T> *add_action(Action<T> *action);
+  Action<T> *add_action_front(Action<T> *action);
   void add_actions(const std::vector<Action<T> *> &actions);
   void play(T x);
   void stop();
@@ -258,6 +481,7 @@ class Automation {
   void add_conditions(const std::vector<Condition<T> *> &conditions);
 
   Action<T> *add_action(Action<T> *action);
+  Action<T> *add_action_front(Action<T> *action);
   void add_actions(const std::vector<Action<T> *> &actions);
 
   void process_trigger_(T x);
@@ -353,15 +577,51 @@ void Action<T>::stop_next() {
     this->next_->stop();
   }
 }
+template<typename T>
+void Action<T>::drop_run(T x) {
+  this->drop_run_next(x);
+}
+template<typename T>
+void Action<T>::drop_run_next(T x) {
+  if (this->next_ != nullptr) {
+    this->next_->drop_run(x);
+  }
+}
 
 template<typename T>
-DelayAction<T>::DelayAction() = default;
+DelayAction<T>::DelayAction() {
+  for (auto &slot : this->slots_)
+    slot.parent_ = this;
+}
 
 template<typename T>
 void DelayAction<T>::play(T x) {
-  this->set_timeout(this->delay_.value(x), [this, x](){
-    this->play_next(x);
-  });
+  Slot *free = nullptr;
+  for (auto &slot : this->slots_) {
+    if (!slot.is_scheduled()) {
+      free = &slot;
+      break;
+    }
+  }
+  if (free == nullptr) {
+    for (auto *slot : this->extra_slots_) {
+      if (!slot->is_scheduled()) {
+        free = slot;
+        break;
+      }
+    }
+  }
+  if (free == nullptr) {
+    free = new Slot();
+    free->parent_ = this;
+    this->extra_slots_.push_back(free);
+  }
+  free->x_.set(x);
+  global_action_scheduler.schedule(free, this->delay_.value(x));
+}
+template<typename T>
+void DelayAction<T>::Slot::run_task() {
+  this->parent_->play_next(this->x_.get());
 }
 template<typename T>
 void DelayAction<T>::set_delay(std::function<uint32_t(T)> &&delay) {
@@ -372,15 +632,25 @@ void DelayAction<T>::set_delay(uint32_t delay) {
   this->delay_ = delay;
 }
 template<typename T>
-float DelayAction<T>::get_setup_priority() const {
-  return setup_priority::HARDWARE;
-}
-template<typename T>
 void DelayAction<T>::stop() {
-  this->cancel_timeout("");
+  for (auto &slot : this->slots_)
+    global_action_scheduler.cancel(&slot);
+  for (auto *slot : this->extra_slots_)
+    global_action_scheduler.cancel(slot);
   this->stop_next();
 }
 
+template<typename T>
+ContinuationAction<T>::ContinuationAction(Action<T> *parent) : parent_(parent) {}
+template<typename T>
+void ContinuationAction<T>::play(T x) {
+  this->parent_->play_next(x);
+}
+template<typename T>
+void ContinuationAction<T>::drop_run(T x) {
+  this->parent_->drop_run_next(x);
+}
+
 template<typename T>
 Condition<T> *Automation<T>::add_condition(Condition<T> *condition) {
   this->conditions_.push_back(condition);
@@ -398,7 +668,11 @@ Automation<T>::Automation(Trigger<T> *trigger) : trigger_(trigger) {
 }
 template<typename T>
 Action<T> *Automation<T>::add_action(Action<T> *action) {
-  this->actions_.add_action(action);
+  return this->actions_.add_action(action);
+}
+template<typename T>
+Action<T> *Automation<T>::add_action_front(Action<T> *action) {
+  return this->actions_.add_action_front(action);
 }
 template<typename T>
 void Automation<T>::add_actions(const std::vector<Action<T> *> &actions) {
@@ -426,6 +700,21 @@ template<typename T>
 bool LambdaCondition<T>::check(T x) {
   return this->f_(x);
 }
+template<typename T>
+bool StateCondition<T>::check(T x) {
+  return this->result_;
+}
+template<typename T>
+void StateCondition<T>::add_on_change_callback(std::function<void(bool)> &&callback) {
+  this->change_callback_.add(std::move(callback));
+}
+template<typename T>
+void StateCondition<T>::publish_result_(bool result) {
+  if (result == this->result_)
+    return;
+  this->result_ = result;
+  this->change_callback_.call(result);
+}
 
 template<typename T>
 LambdaAction<T>::LambdaAction(std::function<void(T)> &&f) : f_(std::move(f)) {}
@@ -445,6 +734,13 @@ Action<T> *ActionList<T>::add_action(Action<T> *action) {
   return this->actions_end_ = action;
 }
 template<typename T>
+Action<T> *ActionList<T>::add_action_front(Action<T> *action) {
+  action->next_ = this->actions_begin_;
+  if (this->actions_end_ == nullptr)
+    this->actions_end_ = action;
+  return this->actions_begin_ = action;
+}
+template<typename T>
 void ActionList<T>::add_actions(const std::vector<Action<T> *> &actions) {
   for (auto *action : actions) {
     this->add_action(action);
@@ -494,16 +790,12 @@ void IfAction<T>::play(T x) {
 template<typename T>
 void IfAction<T>::add_then(const std::vector<Action<T> *> &actions) {
   this->then_.add_actions(actions);
-  this->then_.add_action(new LambdaAction<T>([this](T x) {
-    this->play_next(x);
-  }));
+  this->then_.add_action(new ContinuationAction<T>(this));
 }
 template<typename T>
 void IfAction<T>::add_else(const std::vector<Action<T> *> &actions) {
   this->else_.add_actions(actions);
-  this->else_.add_action(new LambdaAction<T>([this](T x) {
-    this->play_next(x);
-  }));
+  this->else_.add_action(new ContinuationAction<T>(this));
 }
 template<typename T>
 void IfAction<T>::stop() {
@@ -532,7 +824,7 @@ ScriptExecuteAction<T>::ScriptExecuteAction(Script *script)
 
 template<typename T>
 void ScriptExecuteAction<T>::play(T x) {
-  this->script_->trigger();
+  this->script_->execute();
   this->play_next(x);
 }
 
@@ -605,15 +897,15 @@ WhileAction<T>::WhileAction(const std::vector<Condition<T> *> &conditions) : con
 template<typename T>
 void WhileAction<T>::add_then(const std::vector<Action<T> *> &actions) {
   this->then_.add_actions(actions);
-  this->then_.add_action(new LambdaAction<T>([this](T x) {
-    this->is_running_ = false;
-    this->play(x);
-  }));
+  this->then_.add_action(new LoopAction(this));
 }
 template<typename T>
 void WhileAction<T>::play(T x) {
-  if (this->is_running_)
+  if (this->is_running_) {
+    // Another run is looping already, this one ends here.
+    this->drop_run_next(x);
     return;
+  }
 
   for (auto *condition : this->conditions_) {
     if (!condition->check(x)) {
@@ -629,6 +921,18 @@ void WhileAction<T>::stop() {
   this->then_.stop();
   this->stop_next();
 }
+template<typename T>
+WhileAction<T>::LoopAction::LoopAction(WhileAction<T> *parent) : parent_(parent) {}
+template<typename T>
+void WhileAction<T>::LoopAction::play(T x) {
+  this->parent_->is_running_ = false;
+  this->parent_->play(x);
+}
+template<typename T>
+void WhileAction<T>::LoopAction::drop_run(T x) {
+  this->parent_->is_running_ = false;
+  this->parent_->drop_run_next(x);
+}
 
 ESPHOMELIB_NAMESPACE_END
 
@@ -30,7 +30,7 @@ void BinarySensor::send_state_internal_(bool state) {
   this->state = state;
   this->state_callback_.call(state);
 }
-std::string BinarySensor::device_class() {
+const char *BinarySensor::device_class() {
   return "";
 }
 BinarySensor::BinarySensor(const std::string &name)
@@ -44,9 +44,9 @@ BinarySensor::BinarySensor()
 void BinarySensor::set_device_class(const std::string &device_class) {
   this->device_class_ = device_class;
 }
-std::string BinarySensor::get_device_class() {
+const char *BinarySensor::get_device_class() {
   if (this->device_class_.has_value())
-    return *this->device_class_;
+    return this->device_class_->c_str();
   return this->device_class();
 }
 PressTrigger *BinarySensor::make_press_trigger() {
@@ -150,19 +150,20 @@ bool BinarySensor::is_status_binary_sensor() const {
 
 MultiClickTrigger::MultiClickTrigger(BinarySensor *parent, const std::vector<MultiClickTriggerEvent> &timing)
     : parent_(parent), timing_(timing) {
-
-}
-void MultiClickTrigger::setup() {
-  this->last_state_ = this->parent_->state;
-  auto f = std::bind(&MultiClickTrigger::on_state_, this, std::placeholders::_1);
-  this->parent_->add_on_state_callback(f);
-}
-float MultiClickTrigger::get_setup_priority() const {
-  return setup_priority::HARDWARE;
+  if (parent->has_state())
+    this->last_state_ = parent->state;
+  parent->add_on_state_callback([this](bool state) {
+    this->on_state_(state);
+  });
 }
 void MultiClickTrigger::on_state_(bool state) {
+  // The first state is the initial state of the sensor (for example a button that is held at boot), not a click.
+  if (!this->last_state_.has_value()) {
+    this->last_state_ = state;
+    return;
+  }
   // Handle duplicate events
-  if (state == this->last_state_) {
+  if (state == *this->last_state_) {
     return;
   }
   this->last_state_ = state;
@@ -180,9 +181,7 @@ void MultiClickTrigger::on_state_(bool state) {
       ESP_LOGV(TAG, "Multi Click: Starting multi click action!");
       this->at_index_ = 1;
       if (this->timing_.size() == 1 && evt.max_length == 4294967294UL) {
-        this->set_timeout("trigger", evt.min_length, [this]() {
-          this->trigger_();
-        });
+        this->trigger_timer_.schedule(evt.min_length);
       } else {
         this->schedule_is_valid_(evt.min_length);
         this->schedule_is_not_valid_(evt.max_length);
@@ -212,15 +211,13 @@ void MultiClickTrigger::on_state_(bool state) {
     this->schedule_is_not_valid_(evt.max_length);
   } else if (*this->at_index_ + 1 != this->timing_.size()) {
     ESP_LOGV(TAG, "B i=%u min=%u", *this->at_index_, evt.min_length);
-    this->cancel_timeout("is_not_valid");
+    this->not_valid_timer_.cancel();
     this->schedule_is_valid_(evt.min_length);
   } else {
     ESP_LOGV(TAG, "C i=%u min=%u", *this->at_index_, evt.min_length);
     this->is_valid_ = false;
-    this->cancel_timeout("is_not_valid");
-    this->set_timeout("trigger", evt.min_length, [this]() {
-      this->trigger_();
-    });
+    this->not_valid_timer_.cancel();
+    this->trigger_timer_.schedule(evt.min_length);
   }
 
   *this->at_index_ = *this->at_index_ + 1;
@@ -231,35 +228,39 @@ void MultiClickTrigger::set_invalid_cooldown(uint32_t invalid_cooldown) {
 void MultiClickTrigger::schedule_cooldown_() {
   ESP_LOGV(TAG, "Multi Click: Invalid length of press, starting cooldown of %u ms...", this->invalid_cooldown_);
   this->is_in_cooldown_ = true;
-  this->set_timeout("cooldown", this->invalid_cooldown_, [this]() {
-    ESP_LOGV(TAG, "Multi Click: Cooldown ended, matching is now enabled again.");
-    this->is_in_cooldown_ = false;
-  });
+  this->cooldown_timer_.schedule(this->invalid_cooldown_);
   this->at_index_.reset();
-  this->cancel_timeout("trigger");
-  this->cancel_timeout("is_valid");
-  this->cancel_timeout("is_not_valid");
+  this->cancel_timers_();
+}
+void MultiClickTrigger::on_cooldown_end_() {
+  ESP_LOGV(TAG, "Multi Click: Cooldown ended, matching is now enabled again.");
+  this->is_in_cooldown_ = false;
 }
 void MultiClickTrigger::schedule_is_valid_(uint32_t min_length) {
   this->is_valid_ = false;
-  this->set_timeout("is_valid", min_length, [this]() {
-    ESP_LOGV(TAG, "Multi Click: You can now %s the button.", this->parent_->state ? "RELEASE" : "PRESS");
-    this->is_valid_ = true;
-  });
+  this->valid_timer_.schedule(min_length);
+}
+void MultiClickTrigger::on_valid_() {
+  ESP_LOGV(TAG, "Multi Click: You can now %s the button.", this->parent_->state ? "RELEASE" : "PRESS");
+  this->is_valid_ = true;
 }
 void MultiClickTrigger::schedule_is_not_valid_(uint32_t max_length) {
-  this->set_timeout("is_not_valid", max_length, [this]() {
-    ESP_LOGV(TAG, "Multi Click: You waited too long to %s.", this->parent_->state ? "RELEASE" : "PRESS");
-    this->is_valid_ = false;
-    this->schedule_cooldown_();
-  });
+  this->not_valid_timer_.schedule(max_length);
+}
+void MultiClickTrigger::on_not_valid_() {
+  ESP_LOGV(TAG, "Multi Click: You waited too long to %s.", this->parent_->state ? "RELEASE" : "PRESS");
+  this->is_valid_ = false;
+  this->schedule_cooldown_();
+}
+void MultiClickTrigger::cancel_timers_() {
+  this->trigger_timer_.cancel();
+  this->valid_timer_.cancel();
+  this->not_valid_timer_.cancel();
 }
 void MultiClickTrigger::trigger_() {
   ESP_LOGV(TAG, "Multi Click: Hooray, multi click is valid. Triggering!");
   this->at_index_.reset();
-  this->cancel_timeout("trigger");
-  this->cancel_timeout("is_valid");
-  this->cancel_timeout("is_not_valid");
+  this->cancel_timers_();
   this->trigger();
 }
 
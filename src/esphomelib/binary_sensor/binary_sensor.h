@@ -35,8 +35,8 @@ struct MultiClickTriggerEvent {
 #define LOG_BINARY_SENSOR(prefix, type, obj) \
     if (obj != nullptr) { \
       ESP_LOGCONFIG(TAG, prefix type " '%s'", obj->get_name().c_str()); \
-      if (!obj->get_device_class().empty()) { \
-        ESP_LOGCONFIG(TAG, prefix "  Device Class: '%s'", obj->get_device_class().c_str()); \
+      if (obj->get_device_class()[0] != '\0') { \
+        ESP_LOGCONFIG(TAG, prefix "  Device Class: '%s'", obj->get_device_class()); \
       } \
     }
 
@@ -77,7 +77,7 @@ class BinarySensor : public Nameable {
   void set_device_class(const std::string &device_class);
 
   /// Get the device class for this binary sensor, using the manual override if specified.
-  std::string get_device_class();
+  const char *get_device_class();
 
   PressTrigger *make_press_trigger();
   ReleaseTrigger *make_release_trigger();
@@ -105,8 +105,8 @@ class BinarySensor : public Nameable {
  protected:
   // ========== OVERRIDE METHODS ==========
   // (You'll only need this when creating your own custom binary sensor)
-  /// Get the default device class for this sensor, or empty string for no default.
-  virtual std::string device_class();
+  /// Get the default device class for this sensor, or empty string for no default. Must have static storage duration.
+  virtual const char *device_class();
 
   uint32_t hash_base_() override;
 
@@ -147,14 +147,15 @@ class DoubleClickTrigger : public Trigger<NoArg> {
   uint32_t max_length_; /// Maximum length of click. 0 means no maximum.
 };
 
-class MultiClickTrigger : public Trigger<NoArg>, public Component {
+/** Match a sequence of press and release lengths.
+ *
+ * The timers are run by the shared global_action_scheduler, so a trigger isn't a component and
+ * handling an edge never allocates.
+ */
+class MultiClickTrigger : public Trigger<NoArg> {
  public:
   explicit MultiClickTrigger(BinarySensor *parent, const std::vector<MultiClickTriggerEvent> &timing);
 
-  void setup() override;
-
-  float get_setup_priority() const override;
-
   void set_invalid_cooldown(uint32_t invalid_cooldown);
 
  protected:
@@ -162,15 +163,23 @@ class MultiClickTrigger : public Trigger<NoArg>, public Component {
   void schedule_cooldown_();
   void schedule_is_valid_(uint32_t min_length);
   void schedule_is_not_valid_(uint32_t max_length);
+  void cancel_timers_();
+  void on_cooldown_end_();
+  void on_valid_();
+  void on_not_valid_();
   void trigger_();
 
   BinarySensor *parent_;
   std::vector<MultiClickTriggerEvent> timing_;
   uint32_t invalid_cooldown_{1000};
   optional<size_t> at_index_{};
-  bool last_state_{false};
+  optional<bool> last_state_{}; ///< Unknown until the parent publishes its first state.
   bool is_in_cooldown_{false};
   bool is_valid_{false};
+  ScheduledCallback<MultiClickTrigger> trigger_timer_{this, &MultiClickTrigger::trigger_};
+  ScheduledCallback<MultiClickTrigger> valid_timer_{this, &MultiClickTrigger::on_valid_};
+  ScheduledCallback<MultiClickTrigger> not_valid_timer_{this, &MultiClickTrigger::on_not_valid_};
+  ScheduledCallback<MultiClickTrigger> cooldown_timer_{this, &MultiClickTrigger::on_cooldown_end_};
 };
 
 class StateTrigger : public Trigger<bool> {
@@ -178,11 +187,11 @@ class StateTrigger : public Trigger<bool> {
   explicit StateTrigger(BinarySensor *parent);
 };
 
+/// Whether a binary sensor is in a state, updated from the binary sensor's state callback.
 template<typename T>
-class BinarySensorCondition : public Condition<T> {
+class BinarySensorCondition : public StateCondition<T> {
  public:
   BinarySensorCondition(BinarySensor *parent, bool state);
-  bool check(T x) override;
  protected:
   BinarySensor *parent_;
   bool state_;
@@ -190,11 +199,10 @@ class BinarySensorCondition : public Condition<T> {
 
 template<typename T>
 BinarySensorCondition<T>::BinarySensorCondition(BinarySensor *parent, bool state) : parent_(parent), state_(state) {
-
-}
-template<typename T>
-bool BinarySensorCondition<T>::check(T x) {
-  return this->parent_->state == this->state_;
+  this->result_ = parent->state == state;
+  parent->add_on_state_callback([this](bool value) {
+    this->publish_result_(value == this->state_);
+  });
 }
 
 template<typename T>
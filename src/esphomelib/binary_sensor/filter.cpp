@@ -26,18 +26,15 @@ DelayedOnFilter::DelayedOnFilter(uint32_t delay) : delay_(delay) {
 }
 optional<bool> DelayedOnFilter::new_value(bool value) {
   if (value) {
-    this->set_timeout("ON", this->delay_, [this](){
-      this->output(true);
-    });
+    this->timer_.schedule(this->delay_);
     return {};
   } else {
-    this->cancel_timeout("ON");
+    this->timer_.cancel();
     return false;
   }
 }
-
-float DelayedOnFilter::get_setup_priority() const {
-  return setup_priority::HARDWARE;
+void DelayedOnFilter::on_timer_() {
+  this->output(true);
 }
 
 DelayedOffFilter::DelayedOffFilter(uint32_t delay) : delay_(delay) {
@@ -45,17 +42,15 @@ DelayedOffFilter::DelayedOffFilter(uint32_t delay) : delay_(delay) {
 }
 optional<bool> DelayedOffFilter::new_value(bool value) {
   if (!value) {
-    this->set_timeout("OFF", this->delay_, [this](){
-      this->output(false);
-    });
+    this->timer_.schedule(this->delay_);
     return {};
   } else {
-    this->cancel_timeout("OFF");
+    this->timer_.cancel();
     return true;
   }
 }
-float DelayedOffFilter::get_setup_priority() const {
-  return setup_priority::HARDWARE;
+void DelayedOffFilter::on_timer_() {
+  this->output(false);
 }
 
 optional<bool> InvertFilter::new_value(bool value) {
@@ -77,19 +72,17 @@ optional<bool> UniqueFilter::new_value(bool value) {
   }
 }
 
-HeartbeatFilter::HeartbeatFilter(uint32_t interval) : interval_(interval) {}
+HeartbeatFilter::HeartbeatFilter(uint32_t interval) : interval_(interval) {
+  this->timer_.schedule(this->interval_);
+}
 optional<bool> HeartbeatFilter::new_value(bool value) {
   this->value_ = value;
   return value;
 }
-void HeartbeatFilter::setup() {
-  this->set_interval(this->interval_, [this]() {
-    if (this->value_.has_value())
-      this->output(*this->value_);
-  });
-}
-float HeartbeatFilter::get_setup_priority() const {
-  return setup_priority::HARDWARE;
+void HeartbeatFilter::on_timer_() {
+  this->timer_.schedule(this->interval_);
+  if (this->value_.has_value())
+    this->output(*this->value_);
 }
 } // namespace binary_sensor
 
@@ -28,43 +28,47 @@ class Filter {
   BinarySensor *parent_{nullptr};
 };
 
-class DelayedOnFilter : public Filter, public Component {
+/// Only output ON after the input has been ON for delay ms. The timer is run by global_action_scheduler.
+class DelayedOnFilter : public Filter {
  public:
   explicit DelayedOnFilter(uint32_t delay);
 
   optional<bool> new_value(bool value) override;
 
-  float get_setup_priority() const override;
-
  protected:
+  void on_timer_();
+
   uint32_t delay_;
+  ScheduledCallback<DelayedOnFilter> timer_{this, &DelayedOnFilter::on_timer_};
 };
 
-class DelayedOffFilter : public Filter, public Component {
+/// Only output OFF after the input has been OFF for delay ms. The timer is run by global_action_scheduler.
+class DelayedOffFilter : public Filter {
  public:
   explicit DelayedOffFilter(uint32_t delay);
 
   optional<bool> new_value(bool value) override;
 
-  float get_setup_priority() const override;
-
  protected:
+  void on_timer_();
+
   uint32_t delay_;
+  ScheduledCallback<DelayedOffFilter> timer_{this, &DelayedOffFilter::on_timer_};
 };
 
-class HeartbeatFilter : public Filter, public Component {
+/// Re-send the last value every interval ms. The timer is run by global_action_scheduler.
+class HeartbeatFilter : public Filter {
  public:
   explicit HeartbeatFilter(uint32_t interval);
 
   optional<bool> new_value(bool value) override;
 
-  void setup();
-
-  float get_setup_priority() const override;
-
  protected:
+  void on_timer_();
+
   uint32_t interval_;
   optional<bool> value_{};
+  ScheduledCallback<HeartbeatFilter> timer_{this, &HeartbeatFilter::on_timer_};
 };
 
 class InvertFilter : public Filter {
@@ -5,6 +5,9 @@
 #include "esphomelib/binary_sensor/gpio_binary_sensor_component.h"
 #include "esphomelib/esphal.h"
 #include "esphomelib/log.h"
+#ifdef ARDUINO_ARCH_ESP8266
+  #include "FunctionalInterrupt.h"
+#endif
 
 ESPHOMELIB_NAMESPACE_BEGIN
 
@@ -17,14 +20,42 @@ void GPIOBinarySensorComponent::setup() {
   this->pin_->setup();
   this->last_state_ = this->pin_->digital_read();
   this->publish_state(this->last_state_);
+
+  if (this->use_interrupt_) {
+    this->isr_pin_ = this->pin_->to_fast_gpio();
+    this->isr_state_ = this->last_state_;
+#ifdef ARDUINO_ARCH_ESP8266
+    auto intr = std::bind(&GPIOBinarySensorComponent::gpio_intr_, this);
+    attachInterrupt(digitalPinToInterrupt(this->pin_->get_pin()), intr, CHANGE);
+#endif
+#ifdef ARDUINO_ARCH_ESP32
+    attachInterruptArg(digitalPinToInterrupt(this->pin_->get_pin()), &GPIOBinarySensorComponent::gpio_intr_arg_, this,
+                       CHANGE);
+#endif
+  }
+}
+#ifdef ARDUINO_ARCH_ESP32
+void ICACHE_RAM_ATTR HOT GPIOBinarySensorComponent::gpio_intr_arg_(void *arg) {
+  reinterpret_cast<GPIOBinarySensorComponent *>(arg)->gpio_intr_();
 }
+#endif
 
 void GPIOBinarySensorComponent::dump_config() {
   LOG_BINARY_SENSOR("", "GPIO Binary Sensor", this);
   LOG_PIN("  Pin: ", this->pin_);
+  if (this->use_interrupt_) {
+    ESP_LOGCONFIG(TAG, "  Mode: Interrupt");
+    ESP_LOGCONFIG(TAG, "  Debounce: %u us", this->debounce_us_);
+  }
 }
 
 void GPIOBinarySensorComponent::loop() {
+  if (this->use_interrupt_) {
+    if (this->edges_head_ != this->edges_tail_ || this->edges_overflow_)
+      this->process_edges_();
+    return;
+  }
+
   bool new_state = this->pin_->digital_read();
   if (this->last_state_ != new_state) {
     this->last_state_ = new_state;
@@ -32,6 +63,67 @@ void GPIOBinarySensorComponent::loop() {
   }
 }
 
+void ICACHE_RAM_ATTR HOT GPIOBinarySensorComponent::gpio_intr_() {
+  const uint32_t now = micros();
+  const bool state = this->isr_pin_.digital_read();
+  if (state == this->isr_state_)
+    return;
+
+  const uint8_t head = this->edges_head_;
+  if (uint8_t(head - this->edges_tail_) >= GPIO_BINARY_SENSOR_EDGE_BUFFER) {
+    // loop() re-reads the pin when it sees this.
+    this->edges_overflow_ = true;
+    return;
+  }
+  Edge &edge = this->edges_[head & (GPIO_BINARY_SENSOR_EDGE_BUFFER - 1)];
+  edge.time = now;
+  edge.state = state;
+  this->isr_state_ = state;
+  this->edges_head_ = head + 1;
+}
+
+void GPIOBinarySensorComponent::process_edges_() {
+  uint8_t tail = this->edges_tail_;
+  while (tail != this->edges_head_) {
+    const Edge &edge = this->edges_[tail & (GPIO_BINARY_SENSOR_EDGE_BUFFER - 1)];
+    const uint8_t next = tail + 1;
+    if (this->debounce_us_ != 0) {
+      if (next != this->edges_head_) {
+        const Edge &next_edge = this->edges_[next & (GPIO_BINARY_SENSOR_EDGE_BUFFER - 1)];
+        if (next_edge.time - edge.time < this->debounce_us_) {
+          // Bounce, the pin didn't stay at this level for long enough.
+          tail = next;
+          continue;
+        }
+      } else if (micros() - edge.time < this->debounce_us_) {
+        // Not stable yet, check again in the next loop().
+        break;
+      }
+    }
+
+    const bool state = edge.state;
+    tail = next;
+    if (state != this->last_state_) {
+      this->last_state_ = state;
+      this->publish_state(state);
+    }
+  }
+  this->edges_tail_ = tail;
+
+  if (this->edges_overflow_ && tail == this->edges_head_) {
+    ESP_LOGW(TAG, "'%s': Too many edges between loop iterations, re-reading pin.", this->name_.c_str());
+    disable_interrupts();
+    const bool state = this->isr_pin_.digital_read();
+    this->isr_state_ = state;
+    this->edges_overflow_ = false;
+    enable_interrupts();
+    if (state != this->last_state_) {
+      this->last_state_ = state;
+      this->publish_state(state);
+    }
+  }
+}
+
 float GPIOBinarySensorComponent::get_setup_priority() const {
   return setup_priority::HARDWARE;
 }
@@ -39,6 +131,12 @@ GPIOBinarySensorComponent::GPIOBinarySensorComponent(const std::string &name, GP
   : BinarySensor(name), pin_(pin) {
 
 }
+void GPIOBinarySensorComponent::set_use_interrupt(bool use_interrupt) {
+  this->use_interrupt_ = use_interrupt;
+}
+void GPIOBinarySensorComponent::set_debounce_us(uint32_t debounce_us) {
+  this->debounce_us_ = debounce_us;
+}
 
 } // namespace binary_sensor
 
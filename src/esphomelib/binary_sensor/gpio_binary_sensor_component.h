@@ -12,9 +12,17 @@ ESPHOMELIB_NAMESPACE_BEGIN
 
 namespace binary_sensor {
 
+/// The number of edges the interrupt mode can buffer between two loop() calls, must be a power of two.
+static const uint8_t GPIO_BINARY_SENSOR_EDGE_BUFFER = 16;
+
 /** Simple binary_sensor component for a GPIO pin.
  *
  * This class allows you to observe the digital state of a certain GPIO pin.
+ *
+ * By default, the pin is read every loop() iteration. In interrupt mode, an ISR records every edge together
+ * with its micros() timestamp, so loop() only does work when the pin changed and presses shorter than a
+ * loop iteration aren't missed. An edge is only published once the pin stayed at the new level for the
+ * debounce time.
  */
 class GPIOBinarySensorComponent : public BinarySensor, public Component {
  public:
@@ -35,9 +43,36 @@ class GPIOBinarySensorComponent : public BinarySensor, public Component {
   /// Check sensor
   void loop() override;
 
+  /// Use an interrupt to record edges instead of reading the pin every loop() iteration.
+  void set_use_interrupt(bool use_interrupt);
+  /// Only publish edges after which the pin was stable for this many microseconds (interrupt mode only).
+  void set_debounce_us(uint32_t debounce_us);
+
  protected:
+  struct Edge {
+    uint32_t time;
+    bool state;
+  };
+
+  void gpio_intr_();
+#ifdef ARDUINO_ARCH_ESP32
+  /// Pin interrupt with the sensor passed as arg, a plain IRAM function unlike functional interrupts.
+  static void gpio_intr_arg_(void *arg);
+#endif
+  void process_edges_();
+
   GPIOPin *pin_;
   bool last_state_{false};
+  bool use_interrupt_{false};
+  uint32_t debounce_us_{0};
+  FastGPIO isr_pin_;
+  Edge edges_[GPIO_BINARY_SENSOR_EDGE_BUFFER];
+  /// Written only by the ISR.
+  volatile uint8_t edges_head_{0};
+  /// Written only by loop().
+  volatile uint8_t edges_tail_{0};
+  volatile bool isr_state_{false};
+  volatile bool edges_overflow_{false};
 };
 
 } // namespace binary_sensor
@@ -34,8 +34,9 @@ std::string MQTTBinarySensorComponent::friendly_name() const {
 }
 
 void MQTTBinarySensorComponent::send_discovery(JsonObject &root, mqtt::SendDiscoveryConfig &config) {
-  if (!this->binary_sensor_->get_device_class().empty())
-    root["device_class"] = this->binary_sensor_->get_device_class();
+  const char *device_class = this->binary_sensor_->get_device_class();
+  if (device_class[0] != '\0')
+    root["device_class"] = device_class;
   if (this->is_status_)
     root["payload_on"] = mqtt::global_mqtt_client->get_availability().payload_available;
   if (this->is_status_)
@@ -13,7 +13,7 @@ namespace binary_sensor {
 
 static const char *TAG = "binary_sensor.status";
 
-std::string StatusBinarySensor::device_class() {
+const char *StatusBinarySensor::device_class() {
   return "connectivity";
 }
 StatusBinarySensor::StatusBinarySensor(const std::string &name)
@@ -31,7 +31,7 @@ class StatusBinarySensor : public BinarySensor, public Component {
 
  protected:
   /// "connectivity" device class.
-  std::string device_class() override;
+  const char *device_class() override;
   bool last_status_{false};
 };
 
@@ -117,6 +117,20 @@ void Component::setup_() {
   this->setup_internal();
   this->setup();
 }
+#ifdef USE_HEAP_TRACKER
+HeapStats *Component::get_heap_stats() {
+  return &this->heap_stats_;
+}
+#endif
+const std::string &Component::get_component_name() const {
+  static const std::string EMPTY;
+  if (this->component_nameable_ == nullptr)
+    return EMPTY;
+  return this->component_nameable_->get_name();
+}
+void Component::set_component_nameable(const Nameable *nameable) {
+  this->component_nameable_ = nameable;
+}
 uint32_t Component::get_component_state() const {
   return this->component_state_;
 }
@@ -197,6 +211,27 @@ bool Component::is_failed() {
 bool Component::can_proceed() {
   return true;
 }
+void Component::add_setup_dependency(Component *dependency) {
+  this->setup_dependencies_.push_back(dependency);
+  this->has_setup_dependencies_ = true;
+}
+void Component::set_setup_independent() {
+  this->has_setup_dependencies_ = true;
+}
+bool Component::has_setup_dependencies() const {
+  return this->has_setup_dependencies_;
+}
+bool Component::setup_dependencies_ready() {
+  for (Component *dependency : this->setup_dependencies_) {
+    if (dependency->is_failed())
+      continue;
+    if ((dependency->get_component_state() & COMPONENT_STATE_MASK) == COMPONENT_STATE_CONSTRUCTION)
+      return false;
+    if (!dependency->can_proceed())
+      return false;
+  }
+  return true;
+}
 bool Component::status_has_warning() {
   return this->component_state_ &  STATUS_LED_WARNING;
 }
@@ -231,7 +266,9 @@ void Component::dump_config() {
 
 }
 float Component::get_actual_setup_priority() const {
-  return this->setup_priority_override_.value_or(this->get_setup_priority());
+  if (this->setup_priority_override_.has_value())
+    return *this->setup_priority_override_;
+  return this->get_setup_priority();
 }
 void Component::set_setup_priority(float priority) {
   this->setup_priority_override_ = priority;
@@ -271,6 +308,8 @@ Nameable::Nameable(const std::string &name)
 }
 
 const std::string &Nameable::get_object_id() {
+  if (this->object_id_.empty())
+    return this->name_;
   return this->object_id_;
 }
 bool Nameable::is_internal() const {
@@ -280,14 +319,14 @@ void Nameable::set_internal(bool internal) {
   this->internal_ = internal;
 }
 void Nameable::calc_object_id_() {
-  this->object_id_ = sanitize_string_whitelist(to_lowercase_underscore(this->name_), HOSTNAME_CHARACTER_WHITELIST);
-  // FNV-1 hash
-  uint32_t hash = 2166136261UL;
-  for (char c : this->object_id_) {
-    hash *= 16777619UL;
-    hash ^= c;
+  std::string object_id = sanitize_string_whitelist(to_lowercase_underscore(this->name_), HOSTNAME_CHARACTER_WHITELIST);
+  this->object_id_hash_ = fnv1_hash(object_id.c_str());
+  if (object_id == this->name_) {
+    // Don't keep a second copy of the name around, also releasing the old buffer.
+    std::string().swap(this->object_id_);
+  } else {
+    this->object_id_ = std::move(object_id);
   }
-  this->object_id_hash_ = hash;
 }
 uint32_t Nameable::get_object_id_hash() {
   return this->object_id_hash_;
@@ -5,6 +5,7 @@
 #include <vector>
 #include "esphomelib/defines.h"
 #include "esphomelib/helpers.h"
+#include "esphomelib/heap_tracker.h"
 
 ESPHOMELIB_NAMESPACE_BEGIN
 
@@ -36,6 +37,8 @@ extern uint32_t global_state;
 
 #define LOG_UPDATE_INTERVAL(this) ESP_LOGCONFIG(TAG, "  Update Interval: %u ms", this->get_update_interval());
 
+class Nameable;
+
 /** The base class for all esphomelib components.
  *
  * esphomelib uses components to separate code for self-contained units such as
@@ -118,6 +121,27 @@ class Component {
 
   virtual bool can_proceed();
 
+  /** Make setup() of this component only wait for the given component (and any other declared dependencies).
+   *
+   * By default, a component is only set up once all components before it (by setup priority) are set up and can
+   * proceed. A component with declared dependencies is instead set up as soon as all of its dependencies can
+   * proceed, so that slow setups (like waiting for WiFi) overlap with the initialization of other components.
+   */
+  void add_setup_dependency(Component *dependency);
+
+  /** Declare that setup() of this component doesn't depend on any other component, it's started first.
+   *
+   * For example App.init_wifi(...)->set_setup_independent() to start connecting before even the hardware
+   * components are set up.
+   */
+  void set_setup_independent();
+
+  /// Whether this component declared its setup dependencies explicitly.
+  bool has_setup_dependencies() const;
+
+  /// Whether all declared setup dependencies of this component are set up and can proceed.
+  bool setup_dependencies_ready();
+
   bool status_has_warning();
 
   bool status_has_error();
@@ -134,6 +158,16 @@ class Component {
 
   void status_momentary_error(const std::string &name, uint32_t length = 5000);
 
+#ifdef USE_HEAP_TRACKER
+  /// The allocations this component made in setup() and loop() (and in the callbacks called from there).
+  HeapStats *get_heap_stats();
+#endif
+
+  /// The name of the sensor, switch, ... this component is, for diagnostics logs. Empty if it isn't one.
+  const std::string &get_component_name() const;
+  /// Set by Application::register_component() for components that are also a Nameable.
+  void set_component_nameable(const Nameable *nameable);
+
  protected:
   void loop_internal();
   void setup_internal();
@@ -228,7 +262,13 @@ class Component {
   std::vector<TimeFunction> time_functions_;
 
   uint32_t component_state_{0x0000}; ///< State of this component.
+#ifdef USE_HEAP_TRACKER
+  HeapStats heap_stats_{};
+#endif
+  const Nameable *component_nameable_{nullptr};
   optional<float> setup_priority_override_;
+  std::vector<Component *> setup_dependencies_{};
+  bool has_setup_dependencies_{false};
 };
 
 /** This class simplifies creating components that periodically check a state.
@@ -286,11 +326,19 @@ class Nameable {
   void calc_object_id_();
 
   std::string name_;
-  std::string object_id_;
+  std::string object_id_; ///< Empty if the name is already a valid object ID, then the name is used instead.
   uint32_t object_id_hash_;
   bool internal_{false};
 };
 
+/// The Nameable base of a registered component, nullptr if it has none (see Application::register_component()).
+inline const Nameable *component_nameable(const Nameable *nameable) {
+  return nameable;
+}
+inline const Nameable *component_nameable(const void *component) {
+  return nullptr;
+}
+
 ESPHOMELIB_NAMESPACE_END
 
 #endif //ESPHOMELIB_COMPONENT_H
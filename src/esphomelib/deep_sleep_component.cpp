@@ -3,16 +3,46 @@
 #ifdef USE_DEEP_SLEEP
 
 #include <Esp.h>
+#ifdef ARDUINO_ARCH_ESP8266
+  #include <user_interface.h>
+#endif
 #include "esphomelib/deep_sleep_component.h"
 #include "esphomelib/log.h"
 #include "esphomelib/helpers.h"
 #include "esphomelib/ota_component.h"
+#include "esphomelib/application.h"
+#include "esphomelib/wifi_component.h"
+#include "esphomelib/mqtt/mqtt_client_component.h"
 
 ESPHOMELIB_NAMESPACE_BEGIN
 
 static const char *TAG = "deep_sleep";
 
 bool global_has_deep_sleep = false;
+DeepSleepComponent *global_deep_sleep = nullptr;
+
+static const uint32_t FAST_WAKE_PREFERENCE_TYPE = fnv1_hash("deep_sleep_fast_wake");
+
+#ifdef ARDUINO_ARCH_ESP32
+/// RTC slow memory survives deep sleep, unlike NVS it isn't worn down by writing it on every wake.
+RTC_DATA_ATTR static FastWakeState rtc_fast_wake_state;
+#endif
+
+static bool woke_from_deep_sleep() {
+#ifdef ARDUINO_ARCH_ESP32
+  return esp_sleep_get_wakeup_cause() != ESP_SLEEP_WAKEUP_UNDEFINED;
+#endif
+#ifdef ARDUINO_ARCH_ESP8266
+  return ESP.getResetInfoPtr()->reason == REASON_DEEP_SLEEP_AWAKE;
+#endif
+}
+static uint32_t firmware_hash() {
+  return fnv1_hash(App.get_compilation_time().c_str()) ^ fnv1_hash(App.get_name().c_str());
+}
+
+DeepSleepComponent::DeepSleepComponent() {
+  global_deep_sleep = this;
+}
 
 void DeepSleepComponent::setup() {
   ESP_LOGCONFIG(TAG, "Setting up Deep Sleep...");
@@ -34,6 +64,9 @@ void DeepSleepComponent::dump_config() {
   if (this->loop_cycles_.has_value()) {
     ESP_LOGCONFIG(TAG, "  Loop Cycles: %u", *this->loop_cycles_);
   }
+  if (this->fast_wake_) {
+    ESP_LOGCONFIG(TAG, "  Fast Wake: YES (%s wake)", this->warm_wake_ ? "warm" : "cold");
+  }
 #ifdef ARDUINO_ARCH_ESP32
   if (this->wakeup_pin_.has_value()) {
     LOG_PIN("  Wakeup Pin: ", *this->wakeup_pin_);
@@ -41,6 +74,11 @@ void DeepSleepComponent::dump_config() {
 #endif
 }
 void DeepSleepComponent::loop() {
+  if (this->critical_publishes_done_()) {
+    ESP_LOGD(TAG, "All critical states have been published.");
+    this->begin_sleep_();
+  }
+
   if (this->loop_cycles_.has_value()) {
     if (++this->at_loop_cycle_ >= *this->loop_cycles_)
       this->begin_sleep_();
@@ -72,6 +110,110 @@ void DeepSleepComponent::set_run_cycles(uint32_t cycles) {
 void DeepSleepComponent::set_run_duration(uint32_t time_ms) {
   this->run_duration_ = time_ms;
 }
+void DeepSleepComponent::set_fast_wake(bool fast_wake) {
+  this->fast_wake_ = fast_wake;
+}
+void DeepSleepComponent::load_fast_wake_state_() {
+  if (this->fast_wake_loaded_)
+    return;
+  this->fast_wake_loaded_ = true;
+
+#ifdef ARDUINO_ARCH_ESP8266
+  this->fast_wake_pref_ = global_preferences.make_preference<FastWakeState>(FAST_WAKE_PREFERENCE_TYPE);
+  bool loaded = this->fast_wake_pref_.load(&this->fast_wake_state_);
+#endif
+#ifdef ARDUINO_ARCH_ESP32
+  this->fast_wake_state_ = rtc_fast_wake_state;
+  bool loaded = true;
+#endif
+  // RTC memory is undefined after a power-on reset, only trust it after deep sleep with the same firmware.
+  this->warm_wake_ = loaded && woke_from_deep_sleep() && this->fast_wake_state_.firmware_hash == firmware_hash();
+  if (!this->warm_wake_) {
+    this->fast_wake_state_ = FastWakeState{};
+    this->fast_wake_state_.firmware_hash = firmware_hash();
+  }
+}
+bool DeepSleepComponent::is_warm_wake() {
+  if (!this->fast_wake_)
+    return false;
+  this->load_fast_wake_state_();
+  return this->warm_wake_;
+}
+FastWakeState *DeepSleepComponent::get_fast_wake_state() {
+  if (!this->fast_wake_)
+    return nullptr;
+  this->load_fast_wake_state_();
+  return &this->fast_wake_state_;
+}
+void DeepSleepComponent::save_fast_wake_state_() {
+  if (!this->fast_wake_)
+    return;
+  this->load_fast_wake_state_();
+#ifdef ARDUINO_ARCH_ESP8266
+  this->fast_wake_pref_.save(&this->fast_wake_state_);
+#endif
+#ifdef ARDUINO_ARCH_ESP32
+  rtc_fast_wake_state = this->fast_wake_state_;
+#endif
+}
+#ifdef USE_SENSOR
+void DeepSleepComponent::add_critical_sensor(sensor::Sensor *sensor) {
+  this->critical_sensors_.push_back(sensor);
+}
+#endif
+bool DeepSleepComponent::critical_publishes_done_() {
+#ifdef USE_SENSOR
+  if (this->critical_sensors_.empty())
+    return false;
+  for (auto *sensor : this->critical_sensors_) {
+    if (!sensor->has_state())
+      return false;
+  }
+
+  if (mqtt::global_mqtt_client == nullptr)
+    return true;
+  if (!mqtt::global_mqtt_client->is_connected()) {
+    this->mqtt_connected_cycles_ = 0;
+    return false;
+  }
+  // The states are sent in the loop after the connection is established, give them one loop cycle.
+  if (++this->mqtt_connected_cycles_ < 2)
+    return false;
+  return mqtt::global_mqtt_client->get_pending_acks() == 0;
+#else
+  return false;
+#endif
+}
+void DeepSleepComponent::dump_awake_time_() {
+  uint32_t setup_start = UINT32_MAX;
+  uint32_t setup_end = 0;
+  uint32_t wifi_ready = 0;
+  uint32_t mqtt_ready = 0;
+  for (auto &timing : App.get_setup_timeline()) {
+    if (timing.component == nullptr)
+      continue;
+    setup_start = std::min(setup_start, timing.start);
+    setup_end = std::max(setup_end, timing.ready);
+    if (timing.component == global_wifi_component)
+      wifi_ready = timing.ready;
+    if (timing.component == mqtt::global_mqtt_client)
+      mqtt_ready = timing.ready;
+  }
+  if (setup_start == UINT32_MAX)
+    return;
+
+  const uint32_t now = millis();
+  ESP_LOGI(TAG, "Awake for %ums (%s wake):", now, this->warm_wake_ ? "warm" : "cold");
+  ESP_LOGI(TAG, "  Boot: %ums", setup_start);
+  if (wifi_ready != 0) {
+    ESP_LOGI(TAG, "  WiFi connected: %ums", wifi_ready - setup_start);
+  }
+  if (mqtt_ready != 0 && mqtt_ready >= wifi_ready) {
+    ESP_LOGI(TAG, "  MQTT connected: %ums", mqtt_ready - wifi_ready);
+  }
+  ESP_LOGI(TAG, "  Setup: %ums", setup_end - setup_start);
+  ESP_LOGI(TAG, "  Running: %ums", now - setup_end);
+}
 void DeepSleepComponent::begin_sleep_(bool manual) {
   if (this->prevent_ && !manual) {
     this->next_enter_deep_sleep_ = true;
@@ -91,6 +233,8 @@ void DeepSleepComponent::begin_sleep_(bool manual) {
 #endif
 
   ESP_LOGI(TAG, "Beginning Deep Sleep");
+  this->dump_awake_time_();
+  this->save_fast_wake_state_();
 
   run_safe_shutdown_hooks("deep-sleep");
 
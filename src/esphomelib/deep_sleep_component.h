@@ -8,6 +8,10 @@
 #include "esphomelib/component.h"
 #include "esphomelib/helpers.h"
 #include "esphomelib/automation.h"
+#include "esphomelib/esppreferences.h"
+#ifdef USE_SENSOR
+#include "esphomelib/sensor/sensor.h"
+#endif
 
 ESPHOMELIB_NAMESPACE_BEGIN
 
@@ -33,6 +37,25 @@ struct Ext1Wakeup {
 
 #endif
 
+/** Network state kept in RTC memory across deep sleep.
+ *
+ * With fast wake enabled, warm wakes use it to skip the WiFi scan, DHCP, the MQTT broker DNS lookup and
+ * re-sending retained discovery messages.
+ */
+struct FastWakeState {
+  uint32_t firmware_hash; ///< Hash of the firmware this state was saved with, a new firmware invalidates it.
+  uint32_t ssid_hash; ///< FNV-1 hash of the SSID the BSSID belongs to.
+  uint8_t bssid[6];
+  uint8_t channel;
+  bool discovery_sent; ///< Whether the retained MQTT discovery messages were already sent.
+  uint32_t ip;
+  uint32_t gateway;
+  uint32_t subnet;
+  uint32_t dns1;
+  uint32_t dns2;
+  uint32_t mqtt_broker_ip; ///< 0 if unknown.
+};
+
 template<typename T>
 class EnterDeepSleepAction;
 
@@ -47,6 +70,8 @@ class PreventDeepSleepAction;
  */
 class DeepSleepComponent : public Component {
  public:
+  DeepSleepComponent();
+
   /// Set the duration in ms the component should sleep once it's in deep sleep mode.
   void set_sleep_duration(uint32_t time_ms);
 #ifdef ARDUINO_ARCH_ESP32
@@ -64,6 +89,28 @@ class DeepSleepComponent : public Component {
   /// Set a duration in ms for how long the code should run before entering deep sleep mode.
   void set_run_duration(uint32_t time_ms);
 
+  /** Enable the wake-optimized boot mode.
+   *
+   * The network state (WiFi BSSID/channel/IP, MQTT broker IP) is kept in RTC memory before entering deep sleep.
+   * On the next wake from deep sleep, WiFi connects directly with it, the broker address is not resolved again,
+   * mDNS is not started and retained MQTT discovery messages are not sent again.
+   */
+  void set_fast_wake(bool fast_wake);
+  /// Whether this boot is a wake from deep sleep with a valid fast wake state.
+  bool is_warm_wake();
+  /// The fast wake state to use on this boot and to be updated for the next one, nullptr if fast wake is disabled.
+  FastWakeState *get_fast_wake_state();
+
+#ifdef USE_SENSOR
+  /** Enter deep sleep as soon as this sensor has a state that was delivered to the MQTT broker.
+   *
+   * Once all of these sensors have a state, the MQTT client is connected and no QoS 1/2 publish is waiting for its
+   * acknowledgement, deep sleep is entered without waiting for the run duration. Use QoS 1 for these sensors
+   * if the publish should be acknowledged by the broker before sleeping.
+   */
+  void add_critical_sensor(sensor::Sensor *sensor);
+#endif
+
   void setup() override;
   void dump_config() override;
   void loop() override;
@@ -82,6 +129,14 @@ class DeepSleepComponent : public Component {
   void prevent_deep_sleep();
 
  protected:
+  /// Whether the critical publishes are done and nothing else keeps us awake.
+  bool critical_publishes_done_();
+  /// Load the fast wake state on first use, once the firmware is identified.
+  void load_fast_wake_state_();
+  void save_fast_wake_state_();
+  /// Log how long the phases of this wake took.
+  void dump_awake_time_();
+
   optional<uint64_t> sleep_duration_;
 #ifdef ARDUINO_ARCH_ESP32
   optional<GPIOPin *> wakeup_pin_;
@@ -93,9 +148,21 @@ class DeepSleepComponent : public Component {
   optional<uint32_t> run_duration_;
   bool next_enter_deep_sleep_{false};
   bool prevent_{false};
+  bool fast_wake_{false};
+  bool fast_wake_loaded_{false};
+  bool warm_wake_{false};
+  FastWakeState fast_wake_state_{};
+#ifdef ARDUINO_ARCH_ESP8266
+  ESPPreferenceObject fast_wake_pref_;
+#endif
+#ifdef USE_SENSOR
+  std::vector<sensor::Sensor *> critical_sensors_;
+#endif
+  uint32_t mqtt_connected_cycles_{0};
 };
 
 extern bool global_has_deep_sleep;
+extern DeepSleepComponent *global_deep_sleep;
 
 template<typename T>
 class EnterDeepSleepAction : public Action<T> {
@@ -4,6 +4,7 @@
 #define ESPHOMELIB_VERSION "1.10.0-dev"
 
 #define HOT __attribute__ ((hot))
+#define ALWAYS_INLINE __attribute__ ((always_inline))
 #define ESPDEPRECATED(msg) __attribute__((deprecated(msg)))
 
 #ifndef DOXYGEN
@@ -112,6 +113,7 @@
   #define USE_TEXT_SENSOR
   #define USE_MQTT_SUBSCRIBE_TEXT_SENSOR
   #define USE_VERSION_TEXT_SENSOR
+  #define USE_LOOP_STATS_TEXT_SENSOR
   #define USE_TEMPLATE_TEXT_SENSOR
   #define USE_MQTT_SUBSCRIBE_SENSOR
   #define USE_CSE7766
@@ -230,6 +232,11 @@
     #define USE_SENSOR
   #endif
 #endif
+#ifdef USE_HEAP_SENSOR
+  #ifndef USE_SENSOR
+    #define USE_SENSOR
+  #endif
+#endif
 #ifdef USE_HX711
   #ifndef USE_SENSOR
     #define USE_SENSOR
@@ -573,6 +580,11 @@
     #define USE_TEXT_SENSOR
   #endif
 #endif
+#ifdef USE_LOOP_STATS_TEXT_SENSOR
+  #ifndef USE_TEXT_SENSOR
+    #define USE_TEXT_SENSOR
+  #endif
+#endif
 #ifdef USE_TEMPLATE_TEXT_SENSOR
   #ifndef USE_TEXT_SENSOR
     #define USE_TEXT_SENSOR
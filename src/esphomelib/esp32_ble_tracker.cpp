@@ -762,11 +762,11 @@ void ESP32BLETracker::dump_config() {
   }
 }
 
-std::string ESP32BLERSSISensor::unit_of_measurement() {
+const char *ESP32BLERSSISensor::unit_of_measurement() {
   return "dB";
 }
 
-std::string ESP32BLERSSISensor::icon() {
+const char *ESP32BLERSSISensor::icon() {
   return "mdi:signal";
 }
 int8_t ESP32BLERSSISensor::accuracy_decimals() {
@@ -796,11 +796,11 @@ ESP32BLEPresenceDevice::ESP32BLEPresenceDevice(const std::string &name, uint64_t
     : BinarySensor(name), address_(address) {
 
 }
-std::string ESP32BLEPresenceDevice::device_class() {
+const char *ESP32BLEPresenceDevice::device_class() {
   return "presence";
 }
 
-std::string XiaomiSensor::unit_of_measurement() {
+const char *XiaomiSensor::unit_of_measurement() {
   switch (this->type_) {
     case TYPE_TEMPERATURE:
       return sensor::UNIT_C;
@@ -815,7 +815,7 @@ std::string XiaomiSensor::unit_of_measurement() {
   }
   return "";
 }
-std::string XiaomiSensor::icon() {
+const char *XiaomiSensor::icon() {
   switch (this->type_) {
     case TYPE_TEMPERATURE:
       return sensor::ICON_EMPTY;
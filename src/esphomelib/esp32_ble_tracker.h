@@ -139,7 +139,7 @@ class ESP32BLEPresenceDevice : public binary_sensor::BinarySensor {
  protected:
   friend ESP32BLETracker;
 
-  std::string device_class() override;
+  const char *device_class() override;
 
   uint64_t address_;
 };
@@ -148,8 +148,8 @@ class ESP32BLERSSISensor : public sensor::Sensor {
  public:
   ESP32BLERSSISensor(ESP32BLETracker *parent, const std::string &name, uint64_t address);
 
-  std::string unit_of_measurement() override;
-  std::string icon() override;
+  const char *unit_of_measurement() override;
+  const char *icon() override;
   int8_t accuracy_decimals() override;
   std::string unique_id() override;
   uint32_t update_interval() override;
@@ -174,8 +174,8 @@ class XiaomiSensor : public sensor::Sensor {
 
   XiaomiSensor(XiaomiDevice *parent, Type type, const std::string &name);
 
-  std::string unit_of_measurement() override;
-  std::string icon() override;
+  const char *unit_of_measurement() override;
+  const char *icon() override;
   uint32_t update_interval() override;
   int8_t accuracy_decimals() override;
   std::string unique_id() override;
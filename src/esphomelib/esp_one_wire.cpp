@@ -4,15 +4,31 @@
 
 #include "esphomelib/esp_one_wire.h"
 #include "esphomelib/helpers.h"
+#include "esphomelib/log.h"
+
+#ifdef ARDUINO_ARCH_ESP32
+  #include <algorithm>
+  #include <cstring>
+  #include <driver/gpio.h>
+  #include <rom/gpio.h>
+  #include <soc/gpio_sig_map.h>
+#endif
 
 ESPHOMELIB_NAMESPACE_BEGIN
 
+static const char *TAG = "one_wire";
+
 const uint8_t ONE_WIRE_ROM_SELECT = 0x55;
 const int ONE_WIRE_ROM_SEARCH = 0xF0;
 
-ESPOneWire::ESPOneWire(GPIOPin *pin) : pin_(pin) {}
+ESPOneWire::ESPOneWire(GPIOPin *pin) : pin_(pin), fast_pin_(pin->to_fast_gpio()) {}
 
 bool HOT ESPOneWire::reset() {
+#ifdef ARDUINO_ARCH_ESP32
+  if (this->rmt_enabled_())
+    return this->rmt_reset_();
+#endif
+
   uint8_t retries = 125;
 
   // Wait for communication to clear
@@ -21,74 +37,119 @@ bool HOT ESPOneWire::reset() {
     if (--retries == 0)
       return false;
     delayMicroseconds(2);
-  } while (!this->pin_->digital_read());
+  } while (!this->fast_pin_.digital_read());
 
-  // Send 480µs LOW TX reset pulse
+  // Send 480µs LOW TX reset pulse. Interrupts may stretch this, the devices don't care.
   this->pin_->pin_mode(OUTPUT);
-  this->pin_->digital_write(false);
+  this->fast_pin_.digital_write(false);
   delayMicroseconds(480);
 
+  // The presence pulse has to be sampled within its window, so keep interrupts off for this part.
+  disable_interrupts();
   // Switch into RX mode, letting the pin float
   this->pin_->pin_mode(INPUT_PULLUP);
   // after 15µs-60µs wait time, slave pulls low for 60µs-240µs
   // let's have 70µs just in case
   delayMicroseconds(70);
 
-  bool r = !this->pin_->digital_read();
+  bool r = !this->fast_pin_.digital_read();
+  enable_interrupts();
   delayMicroseconds(410);
   return r;
 }
 
 void HOT ESPOneWire::write_bit(bool bit) {
-  // Initiate write/read by pulling low.
-  this->pin_->pin_mode(OUTPUT);
-  this->pin_->digital_write(false);
+#ifdef ARDUINO_ARCH_ESP32
+  if (this->rmt_enabled_()) {
+    this->rmt_write_bits_(bit, 1);
+    return;
+  }
+#endif
 
   // bus sampled within 15µs and 60µs after pulling LOW.
   if (bit) {
+    // The LOW pulse must not exceed 15µs, so this part can't be interrupted.
+    disable_interrupts();
+    // Initiate write/read by pulling low.
+    this->pin_->pin_mode(OUTPUT);
+    this->fast_pin_.digital_write(false);
     // pull high/release within 15µs
     delayMicroseconds(10);
-    this->pin_->digital_write(true);
+    this->fast_pin_.digital_write(true);
+    enable_interrupts();
     // in total minimum of 60µs long
     delayMicroseconds(55);
   } else {
+    // The LOW pulse must not exceed the 120µs maximum slot length, so this part can't be interrupted either.
+    disable_interrupts();
+    // Initiate write/read by pulling low.
+    this->pin_->pin_mode(OUTPUT);
+    this->fast_pin_.digital_write(false);
     // continue pulling LOW for at least 60µs
     delayMicroseconds(65);
-    this->pin_->digital_write(true);
+    this->fast_pin_.digital_write(true);
+    enable_interrupts();
     // grace period, 1µs recovery time
     delayMicroseconds(5);
   }
 }
 
 bool HOT ESPOneWire::read_bit() {
+#ifdef ARDUINO_ARCH_ESP32
+  if (this->rmt_enabled_())
+    return this->rmt_read_bits_(1);
+#endif
+
   // Initiate read slot by pulling LOW for at least 1µs
+  disable_interrupts();
   this->pin_->pin_mode(OUTPUT);
-  this->pin_->digital_write(false);
+  this->fast_pin_.digital_write(false);
   delayMicroseconds(3);
 
   // release bus, we have to sample within 15µs of pulling low
   this->pin_->pin_mode(INPUT_PULLUP);
   delayMicroseconds(10);
 
-  bool r = this->pin_->digital_read();
+  bool r = this->fast_pin_.digital_read();
+  enable_interrupts();
   // read time slot at least 60µs long + 1µs recovery time between slots
   delayMicroseconds(53);
   return r;
 }
 
 void ESPOneWire::write8(uint8_t val) {
+#ifdef ARDUINO_ARCH_ESP32
+  if (this->rmt_enabled_()) {
+    this->rmt_write_bits_(val, 8);
+    return;
+  }
+#endif
+
   for (uint8_t i = 0; i < 8; i++) {
     this->write_bit(bool((1u << i) & val));
   }
 }
 
 void ESPOneWire::write64(uint64_t val) {
+#ifdef ARDUINO_ARCH_ESP32
+  if (this->rmt_enabled_()) {
+    for (uint8_t i = 0; i < 64; i += 8)
+      this->rmt_write_bits_(uint8_t(val >> i), 8);
+    return;
+  }
+#endif
+
   for (uint8_t i = 0; i < 64; i++) {
     this->write_bit(bool((1ULL << i) & val));
   }
 }
 
 uint8_t ESPOneWire::read8() {
+#ifdef ARDUINO_ARCH_ESP32
+  if (this->rmt_enabled_())
+    return this->rmt_read_bits_(8);
+#endif
+
   uint8_t ret = 0;
   for (uint8_t i = 0; i < 8; i++) {
     ret |= (uint8_t(this->read_bit()) << i);
@@ -213,6 +274,159 @@ GPIOPin *ESPOneWire::get_pin() {
   return this->pin_;
 }
 
+#ifdef ARDUINO_ARCH_ESP32
+// All durations in µs (RMT clock divider 80 -> 1 tick = 1µs)
+static const uint16_t RMT_RESET_DURATION = 480;
+static const uint16_t RMT_SLOT_DURATION = 70;
+static const uint16_t RMT_WRITE_1_LOW = 6;
+static const uint16_t RMT_WRITE_0_LOW = 60;
+static const uint16_t RMT_READ_LOW = 6;
+/// A read slot where the line stays low for longer than this was a 0 from the device.
+static const uint16_t RMT_READ_SAMPLE = 15;
+/// Reception is done once the line doesn't change for this long. Must be longer than any part of a slot.
+static const uint16_t RMT_SLOT_IDLE = RMT_SLOT_DURATION + 30;
+static const uint16_t RMT_RESET_IDLE = RMT_RESET_DURATION + 60;
+/// Glitch filter for the RX channel, in APB clock cycles (80MHz).
+static const uint8_t RMT_RX_FILTER = 30;
+
+void ESPOneWire::set_rmt_channels(rmt_channel_t tx_channel, rmt_channel_t rx_channel) {
+  this->tx_channel_ = tx_channel;
+  this->rx_channel_ = rx_channel;
+}
+void ESPOneWire::set_use_rmt(bool use_rmt) {
+  this->use_rmt_ = use_rmt;
+}
+bool ESPOneWire::rmt_enabled_() {
+  if (!this->use_rmt_)
+    return false;
+  if (!this->rmt_initialized_) {
+    this->rmt_initialized_ = true;
+    if (!this->setup_rmt_()) {
+      ESP_LOGW(TAG, "Setting up RMT for 1-Wire on GPIO%u failed, falling back to bit-banging.", this->pin_->get_pin());
+      this->use_rmt_ = false;
+      return false;
+    }
+  }
+  return true;
+}
+bool ESPOneWire::setup_rmt_() {
+  if (this->tx_channel_ == RMT_CHANNEL_MAX && this->rx_channel_ == RMT_CHANNEL_MAX) {
+    // No explicit channels, only claim them now that the bus is actually used with RMT.
+    this->tx_channel_ = select_next_rmt_channel();
+    this->rx_channel_ = select_next_rmt_channel();
+  }
+  if (this->tx_channel_ >= RMT_CHANNEL_MAX || this->rx_channel_ >= RMT_CHANNEL_MAX)
+    return false;
+  auto gpio = gpio_num_t(this->pin_->get_pin());
+
+  rmt_config_t tx{};
+  tx.rmt_mode = RMT_MODE_TX;
+  tx.channel = this->tx_channel_;
+  tx.gpio_num = gpio;
+  tx.clk_div = 80;
+  tx.mem_block_num = 1;
+  tx.tx_config.loop_en = false;
+  tx.tx_config.carrier_en = false;
+  tx.tx_config.idle_output_en = true;
+  // idle level high == bus released (open drain)
+  tx.tx_config.idle_level = RMT_IDLE_LEVEL_HIGH;
+  if (rmt_config(&tx) != ESP_OK || rmt_driver_install(this->tx_channel_, 0, 0) != ESP_OK)
+    return false;
+
+  rmt_config_t rx{};
+  rx.rmt_mode = RMT_MODE_RX;
+  rx.channel = this->rx_channel_;
+  rx.gpio_num = gpio;
+  rx.clk_div = 80;
+  rx.mem_block_num = 1;
+  rx.rx_config.filter_en = true;
+  rx.rx_config.filter_ticks_thresh = RMT_RX_FILTER;
+  rx.rx_config.idle_threshold = RMT_SLOT_IDLE;
+  if (rmt_config(&rx) != ESP_OK || rmt_driver_install(this->rx_channel_, 512, 0) != ESP_OK)
+    return false;
+  if (rmt_get_ringbuf_handle(this->rx_channel_, &this->ringbuf_) != ESP_OK)
+    return false;
+
+  // Both channels share one open-drain pin with pull-up.
+  PIN_FUNC_SELECT(GPIO_PIN_MUX_REG[gpio], PIN_FUNC_GPIO);
+  gpio_set_direction(gpio, GPIO_MODE_INPUT_OUTPUT_OD);
+  gpio_set_pull_mode(gpio, GPIO_PULLUP_ONLY);
+  gpio_matrix_out(gpio, RMT_SIG_OUT0_IDX + this->tx_channel_, false, false);
+  gpio_matrix_in(gpio, RMT_SIG_IN0_IDX + this->rx_channel_, false);
+  return true;
+}
+size_t ESPOneWire::rmt_transfer_(const rmt_item32_t *tx, size_t tx_len, rmt_item32_t *rx, size_t rx_len,
+                                 uint16_t idle_threshold) {
+  // Discard anything left over from previous transfers.
+  size_t len;
+  void *item;
+  while ((item = xRingbufferReceive(this->ringbuf_, &len, 0)) != nullptr)
+    vRingbufferReturnItem(this->ringbuf_, item);
+
+  rmt_set_rx_idle_thresh(this->rx_channel_, idle_threshold);
+  rmt_rx_start(this->rx_channel_, true);
+  rmt_write_items(this->tx_channel_, tx, tx_len, true);
+
+  size_t received = 0;
+  // The RX channel reports its items once the bus has been idle for idle_threshold µs.
+  auto *data = reinterpret_cast<rmt_item32_t *>(xRingbufferReceive(this->ringbuf_, &len, pdMS_TO_TICKS(10)));
+  if (data != nullptr) {
+    received = std::min(len / sizeof(rmt_item32_t), rx_len);
+    memcpy(rx, data, received * sizeof(rmt_item32_t));
+    vRingbufferReturnItem(this->ringbuf_, data);
+  }
+  rmt_rx_stop(this->rx_channel_);
+  return received;
+}
+bool ESPOneWire::rmt_reset_() {
+  rmt_item32_t tx{};
+  tx.level0 = 0;
+  tx.duration0 = RMT_RESET_DURATION;
+  tx.level1 = 1;
+  tx.duration1 = 0;
+
+  // RX sees our reset pulse, a short high phase and then the presence pulse of the devices.
+  rmt_item32_t rx[2];
+  size_t received = this->rmt_transfer_(&tx, 1, rx, 2, RMT_RESET_IDLE);
+  rmt_set_rx_idle_thresh(this->rx_channel_, RMT_SLOT_IDLE);
+  if (received < 2)
+    return false;
+  return rx[0].level0 == 0 && rx[0].duration0 >= RMT_RESET_DURATION - 2 &&
+         rx[0].level1 == 1 && rx[0].duration1 > 0 &&
+         rx[1].level0 == 0;
+}
+void ESPOneWire::rmt_write_bits_(uint8_t val, uint8_t bits) {
+  rmt_item32_t tx[8];
+  for (uint8_t i = 0; i < bits; i++) {
+    const uint16_t low = (val & (1u << i)) ? RMT_WRITE_1_LOW : RMT_WRITE_0_LOW;
+    tx[i].level0 = 0;
+    tx[i].duration0 = low;
+    tx[i].level1 = 1;
+    tx[i].duration1 = RMT_SLOT_DURATION - low;
+  }
+  rmt_write_items(this->tx_channel_, tx, bits, true);
+}
+uint8_t ESPOneWire::rmt_read_bits_(uint8_t bits) {
+  rmt_item32_t tx[8];
+  for (uint8_t i = 0; i < bits; i++) {
+    tx[i].level0 = 0;
+    tx[i].duration0 = RMT_READ_LOW;
+    tx[i].level1 = 1;
+    tx[i].duration1 = RMT_SLOT_DURATION - RMT_READ_LOW;
+  }
+  rmt_item32_t rx[8];
+  size_t received = this->rmt_transfer_(tx, bits, rx, bits, RMT_SLOT_IDLE);
+
+  uint8_t ret = 0;
+  for (uint8_t i = 0; i < bits; i++) {
+    // Missing slots read as 1s, just like an idle bus would with bit-banging
+    if (i >= received || rx[i].duration0 <= RMT_READ_SAMPLE)
+      ret |= 1u << i;
+  }
+  return ret;
+}
+#endif
+
 ESPHOMELIB_NAMESPACE_END
 
 #endif //USE_ONE_WIRE
@@ -8,6 +8,10 @@
 #include "esphomelib/esphal.h"
 #include <vector>
 
+#ifdef ARDUINO_ARCH_ESP32
+  #include <driver/rmt.h>
+#endif
+
 ESPHOMELIB_NAMESPACE_BEGIN
 
 extern const uint8_t ONE_WIRE_ROM_SELECT;
@@ -17,6 +21,14 @@ extern const int ONE_WIRE_ROM_SEARCH;
  *
  * It's more or less the same as Arduino's internal library but uses some fancy C++ and 64 bit
  * unsigned integers to make our lives easier.
+ *
+ * Interrupts are only disabled for the timing-critical part of each slot (at most ~80µs while sampling
+ * the reset presence pulse), so callers must not disable interrupts around whole transactions.
+ *
+ * On the ESP32 the bus is driven by the RMT peripheral by default: one channel transmits the reset/write/read
+ * slots and a second channel on the same (open-drain) pin records the line, from which presence pulses and
+ * read bits are decoded. The timing is then done entirely in hardware. If no RMT channels are left, this
+ * falls back to bit-banging.
  */
 class ESPOneWire {
  public:
@@ -66,16 +78,51 @@ class ESPOneWire {
 
   GPIOPin *get_pin();
 
+#ifdef ARDUINO_ARCH_ESP32
+  /// Manually set the RMT channels for transmitting and receiving. Defaults to the next two free channels on first use.
+  void set_rmt_channels(rmt_channel_t tx_channel, rmt_channel_t rx_channel);
+  /// Set whether to use the RMT peripheral (the default) or bit-bang the bus.
+  void set_use_rmt(bool use_rmt);
+#endif
+
  protected:
+#ifdef ARDUINO_ARCH_ESP32
+  /// Whether the RMT peripheral should be used, lazily sets up the RMT channels on first use.
+  bool rmt_enabled_();
+  bool setup_rmt_();
+  /** Transmit the given slots and record the bus while doing so.
+   *
+   * @param tx The slots to send.
+   * @param tx_len The number of slots.
+   * @param rx The buffer for the received items, one item per slot.
+   * @param rx_len The size of the rx buffer.
+   * @param idle_threshold Time in µs without an edge after which the reception is complete.
+   * @return The number of received items.
+   */
+  size_t rmt_transfer_(const rmt_item32_t *tx, size_t tx_len, rmt_item32_t *rx, size_t rx_len,
+                       uint16_t idle_threshold);
+  bool rmt_reset_();
+  void rmt_write_bits_(uint8_t val, uint8_t bits);
+  uint8_t rmt_read_bits_(uint8_t bits);
+#endif
+
+
   /// Helper to get the internal 64-bit unsigned rom number as a 8-bit integer pointer.
   inline uint8_t *rom_number8_() { return reinterpret_cast<uint8_t *>(&this->rom_number); }
 
   GPIOPin *pin_;
+  FastGPIO fast_pin_;
   uint8_t last_discrepancy_{0};
   uint8_t last_family_discrepancy_{0};
   bool last_device_flag_{false};
   uint64_t rom_number{0};
-
+#ifdef ARDUINO_ARCH_ESP32
+  bool use_rmt_{true};
+  bool rmt_initialized_{false};
+  rmt_channel_t tx_channel_{RMT_CHANNEL_MAX}; ///< RMT_CHANNEL_MAX until set or allocated on first use.
+  rmt_channel_t rx_channel_{RMT_CHANNEL_MAX};
+  RingbufHandle_t ringbuf_{nullptr};
+#endif
 };
 
 ESPHOMELIB_NAMESPACE_END
@@ -17,6 +17,10 @@ GPIOPin::GPIOPin(uint8_t pin, uint8_t mode, bool inverted)
     gpio_clear_(pin < 32 ? &GPIO.out_w1tc : &GPIO.out1_w1tc.val),
     gpio_read_(pin < 32 ? &GPIO.in : &GPIO.in1.val),
     gpio_mask_(pin < 32 ? (1UL << pin) : (1UL << (pin - 32)))
+#endif
+#ifdef ESPHOMELIB_HOST
+    gpio_read_(&host::gpio_levels[(pin / 32) % 2]),
+    gpio_mask_(1UL << (pin % 32))
 #endif
   {
 
@@ -96,9 +100,34 @@ void ICACHE_RAM_ATTR HOT GPIOPin::digital_write(bool value) {
     (*this->gpio_clear_) = this->gpio_mask_;
   }
 #endif
+#ifdef ESPHOMELIB_HOST
+  digitalWrite(this->pin_, value != this->inverted_);
+#endif
 }
 GPIOPin *GPIOPin::copy() const { return new GPIOPin(*this); }
 
+FastGPIO GPIOPin::to_fast_gpio() {
+#ifdef ARDUINO_ARCH_ESP8266
+  if (this->pin_ == 16)
+    // GPIO16 has no separate set/clear registers
+    return FastGPIO(this);
+  return FastGPIO(this->gpio_read_, &GPOS, &GPOC, this->gpio_mask_, this->inverted_);
+#endif
+#ifdef ARDUINO_ARCH_ESP32
+  return FastGPIO(this->gpio_read_, this->gpio_set_, this->gpio_clear_, this->gpio_mask_, this->inverted_);
+#endif
+#ifdef ESPHOMELIB_HOST
+  // the simulated pins have no set/clear registers
+  return FastGPIO(this);
+#endif
+}
+
+FastGPIO::FastGPIO(GPIOPin *pin) : fallback_(pin) {}
+FastGPIO::FastGPIO(volatile uint32_t *read_reg, volatile uint32_t *set_reg, volatile uint32_t *clear_reg,
+                   uint32_t mask, bool inverted)
+    : read_reg_(read_reg), set_reg_(inverted ? clear_reg : set_reg), clear_reg_(inverted ? set_reg : clear_reg),
+      mask_(mask), invert_mask_(inverted ? mask : 0) {}
+
 void ICACHE_RAM_ATTR HOT GPIOPin::pin_mode(uint8_t mode) {
   pinMode(this->pin_, mode);
 }
@@ -7,6 +7,9 @@
 #ifdef ARDUINO_ARCH_ESP8266
   #include "Arduino.h"
 #endif
+#ifdef ESPHOMELIB_HOST
+  #include "esphomelib/host/host_hal.h"
+#endif
 #include "esphomelib/espmath.h"
 #include "esphomelib/defines.h"
 
@@ -26,6 +29,8 @@ ESPHOMELIB_NAMESPACE_BEGIN
 #define LOG_PIN_PATTERN "GPIO%u (Mode: %s%s)"
 #define LOG_PIN_ARGS(pin) (pin)->get_pin(), (pin)->get_pin_mode_name(), ((pin)->is_inverted() ? ", INVERTED" : "")
 
+class FastGPIO;
+
 /** A high-level abstraction class that can expose a pin together with useful options like pinMode.
  *
  * Set the parameters for this at construction time and use setup() to apply them. The inverted parameter will
@@ -54,6 +59,13 @@ class GPIOPin {
   /// Set the pin mode
   virtual void pin_mode(uint8_t mode);
 
+  /** Get a FastGPIO handle for this pin for use in interrupts and bit-bang loops.
+   *
+   * Pins that aren't internal GPIOs must override this to return a handle that forwards to their
+   * virtual methods.
+   */
+  virtual FastGPIO to_fast_gpio();
+
   /// Get the GPIO pin number.
   uint8_t get_pin() const;
   const char *get_pin_mode_name() const;
@@ -74,6 +86,47 @@ class GPIOPin {
   const bool inverted_;
 };
 
+/** Lightweight handle for reading/writing a GPIO pin from interrupts and bit-bang loops.
+ *
+ * Get one with GPIOPin::to_fast_gpio() in setup(). For internal GPIOs, the register addresses and the
+ * bit mask are precomputed and the inversion is folded into an XOR mask (for reads) and swapped set/clear
+ * registers (for writes), so that each access is a non-virtual, inlined one or two instruction operation.
+ * Pins that can't be accessed through registers (I/O expander pins, GPIO16 on the ESP8266) forward to the
+ * virtual GPIOPin methods.
+ */
+class FastGPIO {
+ public:
+  FastGPIO() = default;
+  /// Create a handle that forwards all calls to the virtual methods of pin.
+  explicit FastGPIO(GPIOPin *pin);
+  FastGPIO(volatile uint32_t *read_reg, volatile uint32_t *set_reg, volatile uint32_t *clear_reg,
+           uint32_t mask, bool inverted);
+
+  inline bool ALWAYS_INLINE digital_read() const {
+    if (this->fallback_ != nullptr)
+      return this->fallback_->digital_read();
+    return ((*this->read_reg_ ^ this->invert_mask_) & this->mask_) != 0;
+  }
+  inline void ALWAYS_INLINE digital_write(bool value) const {
+    if (this->fallback_ != nullptr) {
+      this->fallback_->digital_write(value);
+      return;
+    }
+    *(value ? this->set_reg_ : this->clear_reg_) = this->mask_;
+  }
+  /// Whether accesses forward to the virtual GPIOPin methods, which may be slow (for example I2C transactions).
+  bool has_fallback() const { return this->fallback_ != nullptr; }
+
+ protected:
+  GPIOPin *fallback_{nullptr};
+  volatile uint32_t *read_reg_{nullptr};
+  /// The register that sets the output to the logical value `true` (i.e. clear register if inverted).
+  volatile uint32_t *set_reg_{nullptr};
+  volatile uint32_t *clear_reg_{nullptr};
+  uint32_t mask_{0};
+  uint32_t invert_mask_{0};
+};
+
 /**  Basically just a GPIOPin, but defaults to OUTPUT pinMode.
  *
  * Note that theoretically you can still assign an INPUT pinMode to this - we intentionally don't check this.
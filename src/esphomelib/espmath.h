@@ -1,7 +1,11 @@
 #ifndef ESPHOMELIB_ESPMATH_H
 #define ESPHOMELIB_ESPMATH_H
 
-#include "Arduino.h"
+#ifdef ESPHOMELIB_HOST
+  #include "esphomelib/host/host_hal.h"
+#else
+  #include "Arduino.h"
+#endif
 
 #ifdef round
 #undef round
@@ -171,6 +171,33 @@ void ESPPreferences::begin(const std::string &name) {
   this->preferences_.begin(key.c_str());
 }
 
+ESPPreferenceObject ESPPreferences::make_preference(size_t length, uint32_t type) {
+  auto pref = ESPPreferenceObject(this->current_offset_, length, type);
+  this->current_offset_++;
+  return pref;
+}
+#endif
+
+#ifdef ESPHOMELIB_HOST
+bool ESPPreferenceObject::save_internal_() {
+  global_preferences.storage_[this->rtc_offset_].assign(this->data_, this->data_ + this->length_words_ + 1);
+  return true;
+}
+bool ESPPreferenceObject::load_internal_() {
+  auto it = global_preferences.storage_.find(this->rtc_offset_);
+  if (it == global_preferences.storage_.end() || it->second.size() != this->length_words_ + 1)
+    return false;
+  std::copy(it->second.begin(), it->second.end(), this->data_);
+  return true;
+}
+ESPPreferences::ESPPreferences()
+    : current_offset_(0) {
+
+}
+void ESPPreferences::begin(const std::string &name) {
+
+}
+
 ESPPreferenceObject ESPPreferences::make_preference(size_t length, uint32_t type) {
   auto pref = ESPPreferenceObject(this->current_offset_, length, type);
   this->current_offset_++;
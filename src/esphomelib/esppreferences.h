@@ -6,6 +6,10 @@
 #ifdef ARDUINO_ARCH_ESP32
   #include <Preferences.h>
 #endif
+#ifdef ESPHOMELIB_HOST
+  #include <map>
+  #include <vector>
+#endif
 
 #include "esphomelib/espmath.h"
 #include "esphomelib/defines.h"
@@ -69,6 +73,10 @@ class ESPPreferences {
 #ifdef ARDUINO_ARCH_ESP8266
   bool prevent_write_{false};
 #endif
+#ifdef ESPHOMELIB_HOST
+  /// The saved preferences of native builds, by offset. Kept in memory only.
+  std::map<size_t, std::vector<uint32_t>> storage_;
+#endif
 };
 
 extern ESPPreferences global_preferences;
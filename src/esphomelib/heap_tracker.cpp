@@ -0,0 +1,123 @@
+#include "esphomelib/heap_tracker.h"
+#include "esphomelib/helpers.h"
+
+#include "esphomelib/esphal.h"
+#include <cstdlib>
+#include <new>
+
+#ifdef ARDUINO_ARCH_ESP32
+  #include <esp_heap_caps.h>
+#endif
+
+ESPHOMELIB_NAMESPACE_BEGIN
+
+#ifdef USE_HEAP_TRACKER
+HeapStats heap_tracker_other;
+HeapStats *heap_tracker_current = &heap_tracker_other;
+
+#ifdef ARDUINO_ARCH_ESP32
+/// Stored in front of every tracked allocation.
+struct HeapBlockHeader {
+  HeapStats *owner;
+  uint32_t size;
+};
+
+static uint32_t heap_tracker_allocations = 0;
+// Other tasks (WiFi, AsyncTCP) allocate too.
+static portMUX_TYPE heap_tracker_lock = portMUX_INITIALIZER_UNLOCKED;
+static TaskHandle_t heap_tracker_loop_task = nullptr;
+
+static void *heap_tracker_alloc(size_t size) {
+  auto *header = static_cast<HeapBlockHeader *>(malloc(size + sizeof(HeapBlockHeader)));
+  if (header == nullptr)
+    return nullptr;
+
+  HeapStats *owner = heap_tracker_current;
+  if (xTaskGetCurrentTaskHandle() != heap_tracker_loop_task)
+    owner = &heap_tracker_other;
+
+  header->owner = owner;
+  header->size = size;
+  portENTER_CRITICAL(&heap_tracker_lock);
+  owner->live_bytes += size;
+  if (owner->live_bytes > owner->peak_bytes)
+    owner->peak_bytes = owner->live_bytes;
+  owner->allocations++;
+  heap_tracker_allocations++;
+  portEXIT_CRITICAL(&heap_tracker_lock);
+  return header + 1;
+}
+static void heap_tracker_free(void *ptr) {
+  if (ptr == nullptr)
+    return;
+  auto *header = static_cast<HeapBlockHeader *>(ptr) - 1;
+  portENTER_CRITICAL(&heap_tracker_lock);
+  header->owner->live_bytes -= header->size;
+  portEXIT_CRITICAL(&heap_tracker_lock);
+  free(header);
+}
+
+void heap_tracker_begin() {
+  heap_tracker_loop_task = xTaskGetCurrentTaskHandle();
+}
+uint32_t heap_tracker_total_allocations() {
+  return heap_tracker_allocations;
+}
+#endif
+
+#ifdef ARDUINO_ARCH_ESP8266
+void heap_tracker_begin() {
+
+}
+uint32_t heap_tracker_total_allocations() {
+  return 0;
+}
+#endif
+#endif //USE_HEAP_TRACKER
+
+#if defined(USE_HEAP_SENSOR) || defined(USE_HEAP_TRACKER)
+uint32_t heap_largest_free_block() {
+#ifdef ARDUINO_ARCH_ESP32
+  return heap_caps_get_largest_free_block(MALLOC_CAP_8BIT);
+#endif
+#ifdef ARDUINO_ARCH_ESP8266
+  // Requires ESP8266 Arduino core 2.5.0 or newer
+  return ESP.getMaxFreeBlockSize();
+#endif
+}
+float heap_fragmentation() {
+  uint32_t free_heap = ESP.getFreeHeap();
+  if (free_heap == 0)
+    return 0.0f;
+  return 100.0f - (heap_largest_free_block() * 100.0f) / free_heap;
+}
+#endif
+
+ESPHOMELIB_NAMESPACE_END
+
+#if defined(USE_HEAP_TRACKER) && defined(ARDUINO_ARCH_ESP32)
+void *operator new(size_t size) {
+  return esphomelib::heap_tracker_alloc(size);
+}
+void *operator new[](size_t size) {
+  return esphomelib::heap_tracker_alloc(size);
+}
+void *operator new(size_t size, const std::nothrow_t &) noexcept {
+  return esphomelib::heap_tracker_alloc(size);
+}
+void *operator new[](size_t size, const std::nothrow_t &) noexcept {
+  return esphomelib::heap_tracker_alloc(size);
+}
+void operator delete(void *ptr) noexcept {
+  esphomelib::heap_tracker_free(ptr);
+}
+void operator delete[](void *ptr) noexcept {
+  esphomelib::heap_tracker_free(ptr);
+}
+void operator delete(void *ptr, const std::nothrow_t &) noexcept {
+  esphomelib::heap_tracker_free(ptr);
+}
+void operator delete[](void *ptr, const std::nothrow_t &) noexcept {
+  esphomelib::heap_tracker_free(ptr);
+}
+#endif
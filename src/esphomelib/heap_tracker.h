@@ -0,0 +1,62 @@
+#ifndef ESPHOMELIB_HEAP_TRACKER_H
+#define ESPHOMELIB_HEAP_TRACKER_H
+
+#include "esphomelib/defines.h"
+
+#include <cstdint>
+#include <cstddef>
+
+ESPHOMELIB_NAMESPACE_BEGIN
+
+/// Allocation statistics of one component (or of everything that runs outside of components).
+struct HeapStats {
+  /// The bytes currently allocated with operator new and not yet freed.
+  int32_t live_bytes{0};
+  /// The highest value live_bytes had.
+  int32_t peak_bytes{0};
+  /// The number of allocations so far.
+  uint32_t allocations{0};
+};
+
+#ifdef USE_HEAP_TRACKER
+/** The statistics new allocations are attributed to.
+ *
+ * Application sets this to the running component around every setup_() and loop_() call. With
+ * USE_HEAP_TRACKER, operator new/delete are replaced to keep these statistics up to date (ESP32 only, the
+ * ESP8266 core defines operator new in the same object as other C++ ABI functions, so it can't be replaced).
+ * Every allocation then has an 8 byte header that records its owner and size.
+ */
+extern HeapStats *heap_tracker_current;
+/// Allocations made outside of components, for example by the network stack.
+extern HeapStats heap_tracker_other;
+
+/// Attribute the allocations in a scope to stats.
+class HeapTrackerScope {
+ public:
+  explicit HeapTrackerScope(HeapStats *stats) : previous_(heap_tracker_current) {
+    heap_tracker_current = stats;
+  }
+  ~HeapTrackerScope() {
+    heap_tracker_current = this->previous_;
+  }
+
+ protected:
+  HeapStats *previous_;
+};
+
+/// Start attributing allocations of the calling task (the Arduino loop task) to heap_tracker_current.
+void heap_tracker_begin();
+/// The total number of allocations made with operator new since boot.
+uint32_t heap_tracker_total_allocations();
+#endif
+
+#if defined(USE_HEAP_SENSOR) || defined(USE_HEAP_TRACKER)
+/// The size of the largest block that can currently be allocated, in bytes.
+uint32_t heap_largest_free_block();
+/// Heap fragmentation in percent: how much of the free heap isn't part of the largest free block.
+float heap_fragmentation();
+#endif
+
+ESPHOMELIB_NAMESPACE_END
+
+#endif //ESPHOMELIB_HEAP_TRACKER_H
@@ -3,7 +3,8 @@
 
 #ifdef ARDUINO_ARCH_ESP8266
   #include <ESP8266WiFi.h>
-#else
+#endif
+#ifdef ARDUINO_ARCH_ESP32
   #include <Esp.h>
 #endif
 
@@ -26,6 +27,9 @@ std::string get_mac_address() {
 #endif
 #ifdef ARDUINO_ARCH_ESP8266
   WiFi.macAddress(mac);
+#endif
+#ifdef ESPHOMELIB_HOST
+  host::get_mac_address(mac);
 #endif
   sprintf(tmp, "%02x%02x%02x%02x%02x%02x", mac[0], mac[1], mac[2], mac[3], mac[4], mac[5]);
   return std::string(tmp);
@@ -39,6 +43,9 @@ std::string get_mac_address_pretty() {
 #endif
 #ifdef ARDUINO_ARCH_ESP8266
   WiFi.macAddress(mac);
+#endif
+#ifdef ESPHOMELIB_HOST
+  host::get_mac_address(mac);
 #endif
   sprintf(tmp, "%02X:%02X:%02X:%02X:%02X:%02X", mac[0], mac[1], mac[2], mac[3], mac[4], mac[5]);
   return std::string(tmp);
@@ -55,6 +62,8 @@ std::string generate_hostname(const std::string &base) {
 uint32_t random_uint32() {
 #ifdef ARDUINO_ARCH_ESP32
   return esp_random();
+#elif defined(ESPHOMELIB_HOST)
+  return host::random_uint32();
 #else
   return os_random();
 #endif
@@ -186,6 +195,7 @@ std::string uint32_to_string(uint32_t num) {
   snprintf(buffer, sizeof(buffer), "%04X%04X", address16[1], address16[0]);
   return std::string(buffer);
 }
+#ifndef ESPHOMELIB_HOST_NO_JSON
 static char *global_json_build_buffer = nullptr;
 static size_t global_json_build_buffer_size = 0;
 
@@ -237,6 +247,7 @@ void parse_json(const std::string &data, const json_parse_t &f) {
 
   f(root);
 }
+#endif
 ParseOnOffState parse_on_off(const char *str, const char *on, const char *off) {
   if (on == nullptr && strcasecmp(str, "on") == 0)
     return PARSE_ON;
@@ -341,6 +352,14 @@ rmt_channel_t select_next_rmt_channel() {
   next_rmt_channel = rmt_channel_t(int(next_rmt_channel) + 1); // NOLINT
   return value;
 }
+
+pcnt_unit_t next_pcnt_unit = PCNT_UNIT_0;
+
+pcnt_unit_t select_next_pcnt_unit() {
+  pcnt_unit_t value = next_pcnt_unit;
+  next_pcnt_unit = pcnt_unit_t(int(next_pcnt_unit) + 1); // NOLINT
+  return value;
+}
 #endif
 
 uint8_t reverse_bits_8(uint8_t x) {
@@ -360,10 +379,11 @@ void tick_status_led() {
   }
 #endif
 }
-void ICACHE_RAM_ATTR HOT feed_wdt() {
+bool ICACHE_RAM_ATTR HOT feed_wdt() {
   static uint32_t last_feed = 0;
   uint32_t now = millis();
-  if (now - last_feed > 3) {
+  bool fed = now - last_feed > 3;
+  if (fed) {
 #ifdef ARDUINO_ARCH_ESP8266
     ESP.wdtFeed();
 #endif
@@ -372,12 +392,15 @@ void ICACHE_RAM_ATTR HOT feed_wdt() {
 #endif
   }
   last_feed = now;
+  return fed;
 }
+#ifndef ESPHOMELIB_HOST_NO_JSON
 std::string build_json(const json_build_t &f) {
   size_t len;
   const char *c_str = build_json(f, &len);
   return std::string(c_str, len);
 }
+#endif
 std::string to_string(std::string val) {
   return val;
 }
@@ -432,6 +455,7 @@ uint32_t reverse_bits(uint32_t x) {
   return uint32_t(reverse_bits_16(x & 0xFFFF) << 16) | uint32_t(reverse_bits_16(x >> 16));
 }
 
+#ifndef ESPHOMELIB_HOST_NO_JSON
 VectorJsonBuffer::String::String(VectorJsonBuffer *parent)
     : parent_(parent), start_(parent->size_) {
 
@@ -500,6 +524,7 @@ size_t VectorJsonBuffer::size() const {
 }
 
 VectorJsonBuffer global_json_buffer;
+#endif
 
 static int high_freq_num_requests = 0;
 
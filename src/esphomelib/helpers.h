@@ -2,31 +2,40 @@
 #define ESPHOMELIB_HELPERS_H
 
 #include <string>
-#include <IPAddress.h>
+#ifndef ESPHOMELIB_HOST
+  #include <IPAddress.h>
+#endif
 #include <memory>
 #include <queue>
 #include <functional>
-#include <ArduinoJson.h>
+#ifndef ESPHOMELIB_HOST_NO_JSON
+  #include <ArduinoJson.h>
+#endif
 
 #include "esphomelib/esphal.h"
 #include "esphomelib/defines.h"
 #include "esphomelib/optional.h"
 
-#ifndef JSON_BUFFER_SIZE
-  #define JSON_BUFFER_SIZE (JSON_OBJECT_SIZE(16))
+#ifndef ESPHOMELIB_HOST_NO_JSON
+  #ifndef JSON_BUFFER_SIZE
+    #define JSON_BUFFER_SIZE (JSON_OBJECT_SIZE(16))
+  #endif
 #endif
 
 #ifdef ARDUINO_ARCH_ESP32
   #include <driver/rmt.h>
+  #include <driver/pcnt.h>
 #endif
 
 ESPHOMELIB_NAMESPACE_BEGIN
 
+#ifndef ESPHOMELIB_HOST_NO_JSON
 /// Callback function typedef for parsing JsonObjects.
 using json_parse_t = std::function<void(JsonObject &)>;
 
 /// Callback function typedef for building JsonObjects.
 using json_build_t = std::function<void(JsonObject &)>;
+#endif
 
 /// The characters that are allowed in a hostname.
 extern const char *HOSTNAME_CHARACTER_WHITELIST;
@@ -38,7 +47,8 @@ std::string get_mac_address_pretty();
 
 void tick_status_led();
 
-void feed_wdt();
+/// Feed the watchdog if it has not been fed in the last few milliseconds, returns whether it was fed.
+bool feed_wdt();
 
 std::string to_string(std::string val);
 std::string to_string(int val);
@@ -84,6 +94,7 @@ void run_safe_shutdown_hooks(const char *cause);
 /// Convert the string to lowercase_underscore.
 std::string to_lowercase_underscore(std::string s);
 
+#ifndef ESPHOMELIB_HOST_NO_JSON
 /// Build a JSON string with the provided json build function.
 const char *build_json(const json_build_t &f, size_t *length);
 
@@ -91,6 +102,7 @@ std::string build_json(const json_build_t &f);
 
 /// Parse a JSON string and run the provided json parse function if it's valid.
 void parse_json(const std::string &data, const json_parse_t &f);
+#endif
 
 class HighFrequencyLoopRequester {
  public:
@@ -248,6 +260,11 @@ class CallbackManager<void(Ts...)> {
   std::vector<std::function<void(Ts...)>> callbacks_;
 };
 
+/// FNV-1 hash of a null-terminated string, usable in constant expressions for precomputed object ID hashes.
+constexpr uint32_t fnv1_hash(const char *str, uint32_t hash = 2166136261UL) {
+  return *str == '\0' ? hash : fnv1_hash(str + 1, (hash * 16777619UL) ^ uint8_t(*str));
+}
+
 template<typename T, typename X>
 class TemplatableValue {
  public:
@@ -294,10 +311,15 @@ extern CallbackManager<void(const char *)> safe_shutdown_hooks;
   extern rmt_channel_t next_rmt_channel;
 
   rmt_channel_t select_next_rmt_channel();
+
+  extern pcnt_unit_t next_pcnt_unit;
+
+  pcnt_unit_t select_next_pcnt_unit();
 #endif
 
 void delay_microseconds_accurate(uint32_t usec);
 
+#ifndef ESPHOMELIB_HOST_NO_JSON
 class VectorJsonBuffer : public ArduinoJson::Internals::JsonBufferBase<VectorJsonBuffer> {
  public:
   class String {
@@ -335,6 +357,7 @@ class VectorJsonBuffer : public ArduinoJson::Internals::JsonBufferBase<VectorJso
 };
 
 extern VectorJsonBuffer global_json_buffer;
+#endif
 
 // ================================================
 //                 Definitions
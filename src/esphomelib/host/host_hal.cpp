@@ -0,0 +1,185 @@
+#include "esphomelib/defines.h"
+
+#ifdef ESPHOMELIB_HOST
+
+#include <cstdarg>
+
+#include "esphomelib/host/host_hal.h"
+#include "esphomelib/log.h"
+
+static uint64_t host_micros = 0;
+static uint8_t host_pin_modes[esphomelib::host::GPIO_PIN_COUNT];
+static void (*host_interrupt_handlers[esphomelib::host::GPIO_PIN_COUNT])();
+static int host_interrupt_modes[esphomelib::host::GPIO_PIN_COUNT];
+static uint32_t host_random_state = 1;
+static int host_log_level = ESPHOMELIB_LOG_LEVEL_NONE;
+
+uint32_t millis() {
+  return uint32_t(host_micros / 1000ULL);
+}
+uint32_t micros() {
+  return uint32_t(host_micros);
+}
+void delay(uint32_t ms) {
+  host_micros += uint64_t(ms) * 1000ULL;
+}
+void delayMicroseconds(uint32_t us) {
+  host_micros += us;
+}
+void yield() {
+
+}
+
+void pinMode(uint8_t pin, uint8_t mode) {
+  if (pin < esphomelib::host::GPIO_PIN_COUNT)
+    host_pin_modes[pin] = mode;
+}
+void digitalWrite(uint8_t pin, uint8_t val) {
+  esphomelib::host::set_pin_level(pin, val != LOW);
+}
+int digitalRead(uint8_t pin) {
+  return esphomelib::host::get_pin_level(pin) ? HIGH : LOW;
+}
+
+void attachInterrupt(uint8_t pin, void (*handler)(), int mode) {
+  if (pin >= esphomelib::host::GPIO_PIN_COUNT)
+    return;
+  host_interrupt_handlers[pin] = handler;
+  host_interrupt_modes[pin] = mode;
+}
+void detachInterrupt(uint8_t pin) {
+  if (pin < esphomelib::host::GPIO_PIN_COUNT)
+    host_interrupt_handlers[pin] = nullptr;
+}
+
+void noInterrupts() {
+
+}
+void interrupts() {
+
+}
+
+void EspClass::restart() {
+  ESP_LOGE("host", "restart() called, exiting.");
+  exit(1);
+}
+void EspClass::wdtFeed() {
+
+}
+uint32_t EspClass::getFreeHeap() {
+  return 0;
+}
+
+double pow10(double x) {
+  return pow(10.0, x);
+}
+char *dtostrf(double number, signed char width, unsigned char prec, char *s) {
+  sprintf(s, "%*.*f", width, prec, number);
+  return s;
+}
+
+EspClass ESP;
+
+IPAddress::IPAddress() : IPAddress(0, 0, 0, 0) {
+
+}
+IPAddress::IPAddress(uint8_t first_octet, uint8_t second_octet, uint8_t third_octet, uint8_t fourth_octet)
+    : bytes_{first_octet, second_octet, third_octet, fourth_octet} {
+
+}
+IPAddress::IPAddress(uint32_t address) {
+  memcpy(this->bytes_, &address, 4);
+}
+IPAddress::operator uint32_t() const {
+  uint32_t address;
+  memcpy(&address, this->bytes_, 4);
+  return address;
+}
+bool IPAddress::operator==(const IPAddress &other) const {
+  return memcmp(this->bytes_, other.bytes_, 4) == 0;
+}
+uint8_t IPAddress::operator[](int index) const {
+  return this->bytes_[index];
+}
+
+int esp_log_printf_(int level, const char *tag, const char *format, ...) {
+  va_list arg;
+  va_start(arg, format);
+  int ret = esp_log_vprintf_(level, tag, format, arg);
+  va_end(arg);
+  return ret;
+}
+int esp_log_vprintf_(int level, const char *tag, const char *format, va_list args) {
+  if (level > host_log_level)
+    return 0;
+  int ret = vfprintf(stderr, format, args);
+  fputc('\n', stderr);
+  return ret;
+}
+int esp_idf_log_vprintf_(const char *format, va_list args) {
+  return esp_log_vprintf_(ESPHOMELIB_LOG_LEVEL_INFO, "", format, args);
+}
+
+ESPHOMELIB_NAMESPACE_BEGIN
+
+namespace host {
+
+volatile uint32_t gpio_levels[2] = {0, 0};
+
+uint64_t get_micros() {
+  return host_micros;
+}
+void advance_micros(uint64_t us) {
+  host_micros += us;
+}
+void set_pin_level(uint8_t pin, bool level) {
+  if (pin >= GPIO_PIN_COUNT || get_pin_level(pin) == level)
+    return;
+  if (level) {
+    gpio_levels[pin / 32] |= 1UL << (pin % 32);
+  } else {
+    gpio_levels[pin / 32] &= ~(1UL << (pin % 32));
+  }
+
+  void (*handler)() = host_interrupt_handlers[pin];
+  const int mode = host_interrupt_modes[pin];
+  if (handler != nullptr && (mode == CHANGE || mode == (level ? RISING : FALLING)))
+    handler();
+}
+bool get_pin_level(uint8_t pin) {
+  if (pin >= GPIO_PIN_COUNT)
+    return false;
+  return (gpio_levels[pin / 32] & (1UL << (pin % 32))) != 0;
+}
+uint8_t get_pin_mode(uint8_t pin) {
+  if (pin >= GPIO_PIN_COUNT)
+    return 0;
+  return host_pin_modes[pin];
+}
+void get_mac_address(uint8_t *mac) {
+  const uint8_t host_mac[6] = {0x02, 0x00, 0x00, 0x00, 0x00, 0x01};
+  memcpy(mac, host_mac, 6);
+}
+uint32_t random_uint32() {
+  // xorshift32, deterministic so that runs are reproducible.
+  host_random_state ^= host_random_state << 13;
+  host_random_state ^= host_random_state >> 17;
+  host_random_state ^= host_random_state << 5;
+  return host_random_state;
+}
+void set_log_level(int level) {
+  host_log_level = level;
+}
+void reset() {
+  host_micros = 0;
+  gpio_levels[0] = gpio_levels[1] = 0;
+  memset(host_pin_modes, 0, sizeof(host_pin_modes));
+  memset(host_interrupt_handlers, 0, sizeof(host_interrupt_handlers));
+  host_random_state = 1;
+}
+
+} // namespace host
+
+ESPHOMELIB_NAMESPACE_END
+
+#endif //ESPHOMELIB_HOST
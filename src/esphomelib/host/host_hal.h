@@ -0,0 +1,123 @@
+#ifndef ESPHOMELIB_HOST_HOST_HAL_H
+#define ESPHOMELIB_HOST_HOST_HAL_H
+
+#ifdef ESPHOMELIB_HOST
+
+/** The subset of the Arduino API that the core needs, for native builds on a development host.
+ *
+ * Time comes from a virtual clock that only advances in delay(), delayMicroseconds() and
+ * host::advance_micros(), so runs are deterministic. GPIO levels are kept in memory: GPIOPin
+ * reads them like the input registers of an ESP, and tests or benchmarks drive inputs with
+ * digitalWrite() or host::set_pin_level().
+ */
+
+#include <cstdint>
+#include <cstddef>
+#include <cstring>
+#include <cstdlib>
+#include <cstdio>
+#include <cmath>
+#include <string>
+#include <algorithm>
+
+#include "esphomelib/defines.h"
+
+#define ICACHE_RAM_ATTR
+#define IRAM_ATTR
+
+#define LOW 0x0
+#define HIGH 0x1
+
+#define INPUT 0x01
+#define OUTPUT 0x02
+#define INPUT_PULLUP 0x05
+#define OUTPUT_OPEN_DRAIN 0x12
+#define SPECIAL 0xF0
+#define FUNCTION_1 0x00
+#define FUNCTION_2 0x20
+#define FUNCTION_3 0x40
+#define FUNCTION_4 0x60
+
+#define RISING 0x01
+#define FALLING 0x02
+#define CHANGE 0x03
+
+uint32_t millis();
+uint32_t micros();
+void delay(uint32_t ms);
+void delayMicroseconds(uint32_t us);
+void yield();
+
+void pinMode(uint8_t pin, uint8_t mode);
+void digitalWrite(uint8_t pin, uint8_t val);
+int digitalRead(uint8_t pin);
+
+/// Call handler from set_pin_level()/digitalWrite() when the level of pin changes (RISING, FALLING or CHANGE).
+void attachInterrupt(uint8_t pin, void (*handler)(), int mode);
+void detachInterrupt(uint8_t pin);
+
+void noInterrupts();
+void interrupts();
+
+double pow10(double x);
+char *dtostrf(double number, signed char width, unsigned char prec, char *s);
+
+class EspClass {
+ public:
+  void restart();
+  void wdtFeed();
+  uint32_t getFreeHeap();
+};
+
+extern EspClass ESP;
+
+class IPAddress {
+ public:
+  IPAddress();
+  IPAddress(uint8_t first_octet, uint8_t second_octet, uint8_t third_octet, uint8_t fourth_octet);
+  explicit IPAddress(uint32_t address);
+
+  operator uint32_t() const;
+  bool operator==(const IPAddress &other) const;
+  uint8_t operator[](int index) const;
+
+ protected:
+  uint8_t bytes_[4];
+};
+
+ESPHOMELIB_NAMESPACE_BEGIN
+
+namespace host {
+
+/// The number of simulated GPIO pins.
+static const uint8_t GPIO_PIN_COUNT = 64;
+
+/// The simulated GPIO levels, one bit per pin. GPIOPin reads these like the ESP32 input registers.
+extern volatile uint32_t gpio_levels[2];
+
+/// Get the current time of the virtual clock in µs.
+uint64_t get_micros();
+/// Advance the virtual clock by us µs.
+void advance_micros(uint64_t us);
+/// Set the level of a simulated pin, for example to drive an input.
+void set_pin_level(uint8_t pin, bool level);
+/// Get the level of a simulated pin.
+bool get_pin_level(uint8_t pin);
+/// Get the last pinMode() of a simulated pin.
+uint8_t get_pin_mode(uint8_t pin);
+/// Get the (fixed) MAC address of the simulated chip.
+void get_mac_address(uint8_t *mac);
+/// Get the next number of a deterministic pseudo-random sequence.
+uint32_t random_uint32();
+/// Set the log level up to which log messages are printed to stderr (default: none).
+void set_log_level(int level);
+/// Reset the clock, all pins (and their interrupts) and the random generator to their initial state.
+void reset();
+
+} // namespace host
+
+ESPHOMELIB_NAMESPACE_END
+
+#endif //ESPHOMELIB_HOST
+
+#endif //ESPHOMELIB_HOST_HOST_HAL_H
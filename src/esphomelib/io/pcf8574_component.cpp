@@ -22,6 +22,8 @@ void PCF8574Component::setup() {
   ESP_LOGCONFIG(TAG, "Setting up PCF8574...");
   ESP_LOGCONFIG(TAG, "    Address: 0x%02X", this->address_);
   ESP_LOGCONFIG(TAG, "    Is PCF8575: %s", this->pcf8575_ ? "YES" : "NO");
+  if (this->interrupt_pin_ != nullptr)
+    this->interrupt_pin_->setup();
   if (!this->read_gpio_()) {
     ESP_LOGE(TAG, "PCF8574 not available under 0x%02X", this->address_);
     this->mark_failed();
@@ -31,16 +33,23 @@ void PCF8574Component::setup() {
   this->write_gpio_();
   this->read_gpio_();
 }
+void PCF8574Component::loop() {
+  // With the INT line connected, the cached inputs stay valid until the expander signals a change.
+  if (this->interrupt_pin_ == nullptr || !this->interrupt_pin_->digital_read())
+    this->input_valid_ = false;
+}
 void PCF8574Component::dump_config() {
   ESP_LOGCONFIG(TAG, "PCF8574:");
   ESP_LOGCONFIG(TAG, "    Address: 0x%02X", this->address_);
   ESP_LOGCONFIG(TAG, "    Is PCF8575: %s", YESNO(this->pcf8575_));
+  LOG_PIN("    Interrupt Pin: ", this->interrupt_pin_);
   if (this->is_failed()) {
     ESP_LOGE(TAG, "Communication with PCF8574 failed!");
   }
 }
 bool PCF8574Component::digital_read_(uint8_t pin) {
-  this->read_gpio_();
+  if (!this->input_valid_)
+    this->read_gpio_();
   return this->input_mask_ & (1 << pin);
 }
 void PCF8574Component::digital_write_(uint8_t pin, bool value) {
@@ -71,11 +80,15 @@ void PCF8574Component::pin_mode_(uint8_t pin, uint8_t mode) {
   }
 
   this->write_gpio_();
+  // The pin might have just been released, don't serve its level from before the mode change.
+  this->input_valid_ = false;
 }
 bool PCF8574Component::read_gpio_() {
   if (this->is_failed())
     return false;
 
+  // Also on failure, so that a missing expander doesn't cause a transaction for every read.
+  this->input_valid_ = true;
   if (this->pcf8575_) {
     if (!this->parent_->receive_16_(this->address_, &this->input_mask_, 1)) {
       this->status_set_warning();
@@ -98,6 +111,9 @@ bool PCF8574Component::write_gpio_() {
     return false;
 
   uint16_t value = (this->input_mask_ & ~this->ddr_mask_) | this->port_mask_;
+  // Writes that wouldn't change any level are skipped, everything else goes out immediately.
+  if (this->written_valid_ && value == this->written_value_)
+    return true;
 
   this->parent_->begin_transmission_(this->address_);
   uint8_t data = value & 0xFF;
@@ -108,9 +124,14 @@ bool PCF8574Component::write_gpio_() {
     this->parent_->write_(this->address_, &data, 1);
   }
   if (!this->parent_->end_transmission_(this->address_)) {
+    this->written_valid_ = false;
     this->status_set_warning();
     return false;
   }
+  this->written_value_ = value;
+  this->written_valid_ = true;
+  // Keep cached output levels in sync, the inputs might not be read again until the next INT edge.
+  this->input_mask_ = (this->input_mask_ & ~this->ddr_mask_) | (this->port_mask_ & this->ddr_mask_);
   this->status_clear_warning();
   return true;
 }
@@ -120,6 +141,9 @@ PCF8574GPIOInputPin PCF8574Component::make_input_pin(uint8_t pin, uint8_t mode,
 PCF8574GPIOOutputPin PCF8574Component::make_output_pin(uint8_t pin, bool inverted) {
   return {this, pin, PCF8574_OUTPUT, inverted};
 }
+void PCF8574Component::set_interrupt_pin(const GPIOInputPin &interrupt_pin) {
+  this->interrupt_pin_ = interrupt_pin.copy();
+}
 float PCF8574Component::get_setup_priority() const {
   return setup_priority::HARDWARE;
 }
@@ -133,6 +157,9 @@ bool PCF8574GPIOInputPin::digital_read() {
 void PCF8574GPIOInputPin::digital_write(bool value) {
   this->parent_->digital_write_(this->pin_, value != this->inverted_);
 }
+FastGPIO PCF8574GPIOInputPin::to_fast_gpio() {
+  return FastGPIO(this);
+}
 PCF8574GPIOInputPin::PCF8574GPIOInputPin(PCF8574Component *parent, uint8_t pin, uint8_t mode, bool inverted)
     : GPIOInputPin(pin, mode, inverted), parent_(parent) {}
 GPIOPin *PCF8574GPIOInputPin::copy() const {
@@ -151,6 +178,9 @@ bool PCF8574GPIOOutputPin::digital_read() {
 void PCF8574GPIOOutputPin::digital_write(bool value) {
   this->parent_->digital_write_(this->pin_, value != this->inverted_);
 }
+FastGPIO PCF8574GPIOOutputPin::to_fast_gpio() {
+  return FastGPIO(this);
+}
 PCF8574GPIOOutputPin::PCF8574GPIOOutputPin(PCF8574Component *parent, uint8_t pin, uint8_t mode, bool inverted)
     : GPIOOutputPin(pin, mode, inverted), parent_(parent) {}
 GPIOPin *PCF8574GPIOOutputPin::copy() const {
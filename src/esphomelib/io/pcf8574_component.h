@@ -23,6 +23,13 @@ enum PCF8574GPIOMode {
 class PCF8574GPIOInputPin;
 class PCF8574GPIOOutputPin;
 
+/** PCF8574/PCF8575 I/O expander.
+ *
+ * Inputs are read in one I2C transaction at most once per loop() cycle (on the first digital_read() of that
+ * cycle) and served from a cache. If the INT line is connected, the inputs are only re-read after the
+ * expander signalled a change. Writes and pin mode changes are sent immediately, unless they wouldn't change
+ * the levels last written to the expander.
+ */
 class PCF8574Component : public Component, public I2CDevice {
  public:
   PCF8574Component(I2CComponent *parent, uint8_t address, bool pcf8575 = false);
@@ -52,10 +59,20 @@ class PCF8574Component : public Component, public I2CDevice {
    */
   PCF8574GPIOOutputPin make_output_pin(uint8_t pin, bool inverted = false);
 
+  /** Set the pin the (active-low) INT line of the expander is connected to.
+   *
+   * With this, the inputs are only read again over I2C when the expander reports that they changed.
+   *
+   * @param interrupt_pin The pin, should usually be INPUT_PULLUP.
+   */
+  void set_interrupt_pin(const GPIOInputPin &interrupt_pin);
+
   // ========== INTERNAL METHODS ==========
   // (In most use cases you won't need these)
   /// Check i2c availability and setup masks
   void setup() override;
+  /// Invalidate the input cache.
+  void loop() override;
   /// Helper function to read the value of a pin.
   bool digital_read_(uint8_t pin);
   /// Helper function to write the value of a pin.
@@ -76,6 +93,10 @@ class PCF8574Component : public Component, public I2CDevice {
   uint16_t input_mask_{0x00};
   uint16_t port_mask_{0x00};
   bool pcf8575_; ///< TRUE->16-channel PCF8575, FALSE->8-channel PCF8574
+  GPIOPin *interrupt_pin_{nullptr};
+  bool input_valid_{false}; ///< Whether input_mask_ is up to date for this loop cycle.
+  uint16_t written_value_{0}; ///< The port value of the last successful write.
+  bool written_valid_{false}; ///< Whether written_value_ is known.
 };
 
 /// Helper class to expose a PCF8574 pin as an internal input GPIO pin.
@@ -89,6 +110,7 @@ class PCF8574GPIOInputPin : public GPIOInputPin {
   void pin_mode(uint8_t mode) override;
   bool digital_read() override;
   void digital_write(bool value) override;
+  FastGPIO to_fast_gpio() override;
 
  protected:
   PCF8574Component *parent_;
@@ -105,6 +127,7 @@ class PCF8574GPIOOutputPin : public GPIOOutputPin {
   void pin_mode(uint8_t mode) override;
   bool digital_read() override;
   void digital_write(bool value) override;
+  FastGPIO to_fast_gpio() override;
 
  protected:
   PCF8574Component *parent_;
@@ -4,6 +4,8 @@
   #include <esp_log.h>
 #endif
 #include <HardwareSerial.h>
+#include <algorithm>
+#include <cstring>
 
 #include "esphomelib/mqtt/mqtt_client_component.h"
 #include "esphomelib/log.h"
@@ -38,8 +40,17 @@ int HOT LogComponent::log_vprintf_(int level, const char *tag,
     this->tx_buffer_[ret - 1] = '\0';
   }
 
-  if (this->baud_rate_ > 0)
+  if (this->baud_rate_ > 0) {
+#ifdef ARDUINO_ARCH_ESP32
+    if (this->async_task_ != nullptr) {
+      this->write_async_(this->tx_buffer_.data(), strlen(this->tx_buffer_.data()));
+    } else {
+      Serial.println(this->tx_buffer_.data());
+    }
+#else
     Serial.println(this->tx_buffer_.data());
+#endif
+  }
 
   this->log_callback_.call(level, tag, this->tx_buffer_.data());
   return ret;
@@ -56,6 +67,7 @@ void LogComponent::pre_setup() {
 
   global_log_component = this;
 #ifdef ARDUINO_ARCH_ESP32
+  this->start_async_serial_();
   esp_log_set_vprintf(esp_idf_log_vprintf_);
   if (this->global_log_level_ >= ESPHOMELIB_LOG_LEVEL_VERBOSE) {
     esp_log_level_set("*", ESP_LOG_VERBOSE);
@@ -91,6 +103,113 @@ void LogComponent::set_tx_buffer_size(size_t tx_buffer_size) {
 void LogComponent::add_on_log_callback(std::function<void(int, const char *, const char *)> &&callback) {
   this->log_callback_.add(std::move(callback));
 }
+#ifdef ARDUINO_ARCH_ESP32
+void LogComponent::set_async_serial_buffer_size(size_t buffer_size) {
+  this->async_buffer_size_ = buffer_size;
+  // The logger is usually initialized before this is set.
+  if (global_log_component == this)
+    this->start_async_serial_();
+}
+void LogComponent::start_async_serial_() {
+  if (this->baud_rate_ == 0 || this->async_buffer_size_ == 0 || this->async_task_ != nullptr)
+    return;
+  this->async_buffer_ = new char[this->async_buffer_size_];
+  this->async_write_lock_ = xSemaphoreCreateMutex();
+  this->async_drain_lock_ = xSemaphoreCreateMutex();
+  // Write out what's still buffered before rebooting, going to deep sleep or flashing an update. Later log lines
+  // (for example from shutdown hooks registered after this one) are written directly.
+  add_shutdown_hook([this](const char *cause) {
+    this->stop_async_serial_();
+  });
+  xTaskCreatePinnedToCore(
+      LogComponent::async_serial_task,
+      "log_task", // name
+      2048, // stack size (in words)
+      this, // input params
+      1, // priority
+      &this->async_task_, // handle
+      0 // core
+  );
+}
+void LogComponent::stop_async_serial_() {
+  xSemaphoreTake(this->async_write_lock_, portMAX_DELAY);
+  if (this->async_task_ != nullptr) {
+    this->drain_async_();
+    Serial.flush();
+    this->async_task_ = nullptr;
+  }
+  xSemaphoreGive(this->async_write_lock_);
+}
+void HOT LogComponent::write_async_(const char *msg, size_t len) {
+  // Lines from all tasks go through the buffer, so that they're written in the order they were logged.
+  xSemaphoreTake(this->async_write_lock_, portMAX_DELAY);
+  if (this->async_task_ == nullptr) {
+    // Stopped by a shutdown hook in the meantime.
+    Serial.write(reinterpret_cast<const uint8_t *>(msg), len);
+    Serial.write("\r\n");
+    xSemaphoreGive(this->async_write_lock_);
+    return;
+  }
+
+  const size_t size = this->async_buffer_size_;
+  const size_t head = this->async_head_;
+  const size_t tail = this->async_tail_;
+  const size_t available = (tail + size - head - 1) % size;
+
+  char dropped[32];
+  size_t dropped_len = 0;
+  if (this->async_dropped_ > 0)
+    dropped_len = sprintf(dropped, "[%u log lines dropped]\r\n", this->async_dropped_);
+  if (dropped_len + len + 2 > available) {
+    this->async_dropped_++;
+    xSemaphoreGive(this->async_write_lock_);
+    return;
+  }
+  this->async_dropped_ = 0;
+
+  size_t pos = head;
+  auto push = [this, size, &pos](const char *data, size_t data_len) {
+    const size_t first = std::min(data_len, size - pos);
+    memcpy(this->async_buffer_ + pos, data, first);
+    memcpy(this->async_buffer_ + 0, data + first, data_len - first);
+    pos = (pos + data_len) % size;
+  };
+  push(dropped, dropped_len);
+  push(msg, len);
+  push("\r\n", 2);
+
+  // Make the data visible to the other core before publishing the new head.
+  __sync_synchronize();
+  this->async_head_ = pos;
+  xTaskNotifyGive(this->async_task_);
+  xSemaphoreGive(this->async_write_lock_);
+}
+void LogComponent::async_serial_task(void *params) {
+  auto *log = reinterpret_cast<LogComponent *>(params);
+  while (true) {
+    ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+    log->drain_async_();
+  }
+}
+void LogComponent::drain_async_() {
+  const size_t size = this->async_buffer_size_;
+  xSemaphoreTake(this->async_drain_lock_, portMAX_DELAY);
+  while (true) {
+    const size_t head = this->async_head_;
+    __sync_synchronize();
+    const size_t tail = this->async_tail_;
+    if (head == tail)
+      break;
+
+    // Write the contiguous part, a wrapped-around remainder is written in the next iteration.
+    const size_t end = head > tail ? head : size;
+    Serial.write(reinterpret_cast<const uint8_t *>(this->async_buffer_ + tail), end - tail);
+    __sync_synchronize();
+    this->async_tail_ = end % size;
+  }
+  xSemaphoreGive(this->async_drain_lock_);
+}
+#endif
 float LogComponent::get_setup_priority() const {
   return setup_priority::HARDWARE - 1.0f;
 }
@@ -99,6 +218,11 @@ void LogComponent::dump_config() {
   ESP_LOGCONFIG(TAG, "Logger:");
   ESP_LOGCONFIG(TAG, "  Level: %s", LOG_LEVELS[this->global_log_level_]);
   ESP_LOGCONFIG(TAG, "  Log Baud Rate: %u", this->baud_rate_);
+#ifdef ARDUINO_ARCH_ESP32
+  if (this->async_task_ != nullptr) {
+    ESP_LOGCONFIG(TAG, "  Async Serial Buffer: %u bytes", this->async_buffer_size_);
+  }
+#endif
   for (auto &it : this->log_levels_) {
     ESP_LOGCONFIG(TAG, "  Level for '%s': %s", it.tag.c_str(), LOG_LEVELS[it.level]);
   }
@@ -15,6 +15,12 @@
 #include "esphomelib/log.h"
 #include "esphomelib/defines.h"
 
+#ifdef ARDUINO_ARCH_ESP32
+  #include <freertos/FreeRTOS.h>
+  #include <freertos/task.h>
+  #include <freertos/semphr.h>
+#endif
+
 ESPHOMELIB_NAMESPACE_BEGIN
 
 /** A simple component that enables logging to Serial via the ESP_LOG* macros.
@@ -44,6 +50,17 @@ class LogComponent : public Component {
   /// Set the log level of the specified tag.
   void set_log_level(const std::string &tag, int log_level);
 
+#ifdef ARDUINO_ARCH_ESP32
+  /** Write serial logs from a task on the other core, through a ring buffer of this size.
+   *
+   * Writing a log line to the UART blocks the main loop for several ms at 115200 baud. With this, log lines are
+   * only copied into the buffer, and a task pinned to core 0 writes them out. Lines that don't fit into the buffer
+   * are dropped and counted. The buffer is written out before a reboot, OTA update or deep sleep, but lines still
+   * buffered when the chip crashes are lost: use 0 (the default, writes the logs directly) to debug crashes.
+   */
+  void set_async_serial_buffer_size(size_t buffer_size);
+#endif
+
   // ========== INTERNAL METHODS ==========
   // (In most use cases you won't need these)
   /// Set up this component.
@@ -61,6 +78,17 @@ class LogComponent : public Component {
   float get_setup_priority() const override;
 
  protected:
+#ifdef ARDUINO_ARCH_ESP32
+  void start_async_serial_();
+  /// Write out the buffered log lines from the calling task and write all later ones directly (shutdown hook).
+  void stop_async_serial_();
+  /// Copy a log line into the ring buffer (from any task, serialized by async_write_lock_).
+  void write_async_(const char *msg, size_t len);
+  static void async_serial_task(void *params);
+  /// Write the buffered log lines to the UART (serialized by async_drain_lock_).
+  void drain_async_();
+#endif
+
   uint32_t baud_rate_;
   std::vector<char> tx_buffer_;
   int global_log_level_{ESPHOMELIB_LOG_LEVEL};
@@ -70,6 +98,16 @@ class LogComponent : public Component {
   };
   std::vector<LogLevelOverride> log_levels_;
   CallbackManager<void(int, const char *, const char *)> log_callback_{};
+#ifdef ARDUINO_ARCH_ESP32
+  size_t async_buffer_size_{0};
+  char *async_buffer_{nullptr};
+  volatile size_t async_head_{0}; ///< Only written with async_write_lock_ held.
+  volatile size_t async_tail_{0}; ///< Only written with async_drain_lock_ held.
+  uint32_t async_dropped_{0};
+  SemaphoreHandle_t async_write_lock_{nullptr};
+  SemaphoreHandle_t async_drain_lock_{nullptr};
+  TaskHandle_t async_task_{nullptr};
+#endif
 };
 
 extern LogComponent *global_log_component;
@@ -1,4 +1,5 @@
 #include "esphomelib/mqtt/mqtt_client_component.h"
+#include "esphomelib/mqtt/mqtt_topic.h"
 
 #include "esphomelib/log.h"
 #include "esphomelib/application.h"
@@ -33,6 +34,16 @@ void MQTTClientComponent::setup() {
     this->state_ = MQTT_CLIENT_DISCONNECTED;
     this->disconnect_reason_ = reason;
   });
+  this->mqtt_client_.onPublish([this](uint16_t packet_id) {
+    this->acked_++;
+  });
+#ifdef USE_DEEP_SLEEP
+  if (global_deep_sleep != nullptr && global_deep_sleep->is_warm_wake() &&
+      global_deep_sleep->get_fast_wake_state()->discovery_sent && this->discovery_info_.retain) {
+    ESP_LOGD(TAG, "Not sending discovery again after deep sleep, the broker has retained it.");
+    this->skip_discovery_ = true;
+  }
+#endif
   if (this->is_log_message_enabled() && global_log_component != nullptr) {
     global_log_component->add_on_log_callback([this](int level, const char *tag, const char *message) {
       if (level <= this->log_level_ && this->is_connected()) {
@@ -85,6 +96,20 @@ void MQTTClientComponent::start_dnslookup() {
   this->status_set_warning();
   this->dns_resolve_error_ = false;
   this->dns_resolved_ = false;
+
+#ifdef USE_DEEP_SLEEP
+  if (!this->fast_wake_dns_used_ && global_deep_sleep != nullptr && global_deep_sleep->is_warm_wake() &&
+      global_deep_sleep->get_fast_wake_state()->mqtt_broker_ip != 0) {
+    // Only for the first connection attempt, if that fails the address is resolved again.
+    this->fast_wake_dns_used_ = true;
+    this->dns_resolved_ = true;
+    this->ip_ = IPAddress(global_deep_sleep->get_fast_wake_state()->mqtt_broker_ip);
+    ESP_LOGD(TAG, "Using broker IP address %s from before deep sleep", this->ip_.toString().c_str());
+    this->start_connect();
+    return;
+  }
+#endif
+
   ip_addr_t addr;
 #ifdef ARDUINO_ARCH_ESP32
   err_t err = dns_gethostbyname_addrtype(this->credentials_.address.c_str(), &addr, this->dns_found_callback_, this,
@@ -191,6 +216,9 @@ void MQTTClientComponent::start_connect() {
   this->state_ = MQTT_CLIENT_CONNECTING;
   this->connect_begin_ = millis();
 }
+uint32_t MQTTClientComponent::get_pending_acks() const {
+  return this->published_with_ack_ - this->acked_;
+}
 bool MQTTClientComponent::is_connected() {
   return this->state_ == MQTT_CLIENT_CONNECTED && this->mqtt_client_.connected();
 }
@@ -207,6 +235,14 @@ void MQTTClientComponent::check_connected() {
   this->state_ = MQTT_CLIENT_CONNECTED;
   this->status_clear_warning();
   ESP_LOGI(TAG, "MQTT Connected!");
+#ifdef USE_DEEP_SLEEP
+  if (global_deep_sleep != nullptr && global_deep_sleep->get_fast_wake_state() != nullptr) {
+    FastWakeState *state = global_deep_sleep->get_fast_wake_state();
+    state->mqtt_broker_ip = uint32_t(this->ip_);
+    // Discovery is sent (or was already retained) once connected.
+    state->discovery_sent = !this->discovery_info_.prefix.empty() && this->discovery_info_.retain;
+  }
+#endif
   // MQTT Client needs some time to be fully set up.
   delay(100);
 
@@ -256,6 +292,8 @@ void MQTTClientComponent::loop() {
     }
     ESP_LOGW(TAG, "MQTT Disconnected: %s.", reason_s);
     this->disconnect_reason_.reset();
+    // Messages that weren't acknowledged are lost with the session.
+    this->published_with_ack_ = this->acked_;
   }
 
   const uint32_t now = millis();
@@ -377,6 +415,9 @@ bool MQTTClientComponent::publish(const std::string &topic, const char *payload,
     yield();
   }
 
+  if (ret != 0 && qos > 0)
+    this->published_with_ack_++;
+
   if (!logging_topic) {
     if (ret != 0) {
       ESP_LOGV(TAG, "Publish(topic='%s' payload='%s' retain=%d)", topic.c_str(), payload, retain);
@@ -397,63 +438,6 @@ bool MQTTClientComponent::publish_json(const std::string &topic, const json_buil
   return this->publish(topic, message, len, qos, retain);
 }
 
-/** Check if the message topic matches the given subscription topic
- *
- * INFO: MQTT spec mandates that topics must not be empty and must be valid NULL-terminated UTF-8 strings.
- *
- * @param message The message topic that was received from the MQTT server. Note: this must not contain
- *                wildcard characters as mandated by the MQTT spec.
- * @param subscription The subscription topic we are matching against.
- * @param is_normal Is this a "normal" topic - Does the message topic not begin with a "$".
- * @param past_separator Are we past the first '/' topic separator.
- * @return true if the subscription topic matches the message topic, false otherwise.
- */
-static bool topic_match_(const char *message, const char *subscription, bool is_normal, bool past_separator) {
-  // Reached end of both strings at the same time, this means we have a successful match
-  if (*message == '\0' && *subscription == '\0')
-    return true;
-
-  // Either the message or the subscribe are at the end. This means they don't match.
-  if (*message == '\0' || *subscription == '\0')
-    return false;
-
-  bool do_wildcards = is_normal || past_separator;
-
-  if (*subscription == '+' && do_wildcards) {
-    // single level wildcard
-    // consume + from subscription
-    subscription++;
-    // consume everything from message until '/' found or end of string
-    while (*message != '\0' && *message != '/') {
-      message++;
-    }
-    // after this, both pointers will point to a '/' or to the end of the string
-
-    return topic_match_(message, subscription, is_normal, true);
-  }
-
-  if (*subscription == '#' && do_wildcards) {
-    // multilevel wildcard - MQTT mandates that this must be at end of subscribe topic
-    return true;
-  }
-
-  // this handles '/' and normal characters at the same time.
-  if (*message != *subscription)
-    return false;
-
-  past_separator = past_separator || *subscription == '/';
-
-  // consume characters
-  subscription++;
-  message++;
-
-  return topic_match_(message, subscription, is_normal, past_separator);
-}
-
-static bool topic_match(const char *message, const char *subscription) {
-  return topic_match_(message, subscription, *message != '\0' && *message != '$', false);
-}
-
 void MQTTClientComponent::on_message(const std::string &topic, const std::string &payload) {
 #ifdef ARDUINO_ARCH_ESP8266
   // on ESP8266, this is called in LWiP thread; some components do not like running
@@ -530,7 +514,7 @@ void MQTTClientComponent::disable_shutdown_message() {
   this->shutdown_message_.topic = "";
 }
 bool MQTTClientComponent::is_discovery_enabled() const {
-  return !this->discovery_info_.prefix.empty();
+  return !this->discovery_info_.prefix.empty() && !this->skip_discovery_;
 }
 void MQTTClientComponent::set_client_id(std::string client_id) {
   this->credentials_.client_id = std::move(client_id);
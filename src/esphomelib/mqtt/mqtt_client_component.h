@@ -231,6 +231,9 @@ class MQTTClientComponent : public Component {
 
   bool is_connected();
 
+  /// The number of QoS 1/2 messages that were published but not yet acknowledged by the broker.
+  uint32_t get_pending_acks() const;
+
  protected:
   /// Reconnect to the MQTT broker if not already connected.
   void start_connect();
@@ -276,6 +279,10 @@ class MQTTClientComponent : public Component {
   bool dns_resolved_{false};
   bool dns_resolve_error_{false};
   std::vector<MQTTComponent *> children_;
+  uint32_t published_with_ack_{0}; ///< Only written from the main loop.
+  volatile uint32_t acked_{0}; ///< Only written from the publish acknowledgement callback.
+  bool skip_discovery_{false}; ///< Retained discovery messages were already sent before deep sleep.
+  bool fast_wake_dns_used_{false};
   uint32_t reboot_timeout_{300000};
   uint32_t connect_begin_;
   uint32_t last_connected_{0};
@@ -0,0 +1,24 @@
+#ifndef ESPHOMELIB_MQTT_MQTT_TOPIC_H
+#define ESPHOMELIB_MQTT_MQTT_TOPIC_H
+
+#include "esphomelib/defines.h"
+
+ESPHOMELIB_NAMESPACE_BEGIN
+
+namespace mqtt {
+
+/** Check if the message topic matches the given subscription topic, which may contain the '+' and '#' wildcards.
+ *
+ * Topics starting with '$' are only matched by wildcards after their first level, as the MQTT spec mandates.
+ *
+ * @param message The (non-empty) message topic that was received from the MQTT server, without wildcards.
+ * @param subscription The subscription topic we are matching against.
+ * @return true if the subscription topic matches the message topic, false otherwise.
+ */
+bool topic_match(const char *message, const char *subscription);
+
+} // namespace mqtt
+
+ESPHOMELIB_NAMESPACE_END
+
+#endif //ESPHOMELIB_MQTT_MQTT_TOPIC_H
@@ -51,6 +51,8 @@ void MY9231OutputComponent::setup() {
   this->pin_di_->digital_write(false);
   this->pin_dcki_->setup();
   this->pin_dcki_->digital_write(false);
+  this->pin_di_fast_ = this->pin_di_->to_fast_gpio();
+  this->pin_dcki_fast_ = this->pin_dcki_->to_fast_gpio();
   this->pwm_amounts_.resize(this->num_channels_, 0);
   uint8_t command = 0;
   if (this->bit_depth_ <= 8) {
@@ -163,16 +165,16 @@ void MY9231OutputComponent::init_chips(uint8_t command) {
 
 void MY9231OutputComponent::write_word(uint16_t value, uint8_t bits) {
   for (uint8_t i = bits; i > 0; i--) {
-    this->pin_di_->digital_write(value & (1 << (i - 1)));
-    this->pin_dcki_->digital_write(!this->pin_dcki_->digital_read());
+    this->pin_di_fast_.digital_write(value & (1 << (i - 1)));
+    this->pin_dcki_fast_.digital_write(!this->pin_dcki_fast_.digital_read());
   }
 }
 
 void MY9231OutputComponent::send_di_pulses(uint8_t count) {
   delayMicroseconds(12);
   for (uint8_t i = 0; i < count; i++) {
-    this->pin_di_->digital_write(true);
-    this->pin_di_->digital_write(false);
+    this->pin_di_fast_.digital_write(true);
+    this->pin_di_fast_.digital_write(false);
   }
 }
 
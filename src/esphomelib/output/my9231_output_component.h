@@ -85,6 +85,8 @@ class MY9231OutputComponent : public Component {
 
   GPIOPin *pin_di_;
   GPIOPin *pin_dcki_;
+  FastGPIO pin_di_fast_;
+  FastGPIO pin_dcki_fast_;
   uint8_t bit_depth_;
   uint16_t num_channels_;
   uint8_t num_chips_;
@@ -287,7 +287,7 @@ void ICACHE_RAM_ATTR RemoteReceiverComponent::gpio_intr() {
   const uint32_t now = micros();
   // If the lhs is 1 (rising edge) we should write to an uneven index and vice versa
   const uint32_t next = (this->buffer_write_at_ + 1) % this->buffer_size_;
-  if (uint32_t(this->pin_->digital_read()) != next % 2)
+  if (uint32_t(this->isr_pin_.digital_read()) != next % 2)
     return;
   const uint32_t last_change = this->buffer_[this->buffer_write_at_];
   if (now - last_change <= this->filter_us_)
@@ -299,6 +299,7 @@ void ICACHE_RAM_ATTR RemoteReceiverComponent::gpio_intr() {
 void RemoteReceiverComponent::setup() {
   ESP_LOGCONFIG(TAG, "Setting up Remote Receiver...");
   this->pin_->setup();
+  this->isr_pin_ = this->pin_->to_fast_gpio();
   this->high_freq_.start();
   if (this->buffer_size_ % 2 != 0) {
     // Make sure divisible by two. This way, we know that every 0bxxx0 index is a space and every 0bxxx1 index is a mark
@@ -143,6 +143,7 @@ class RemoteReceiverComponent : public RemoteControlComponentBase, public Compon
   volatile uint32_t buffer_write_at_;
   /// The position last read from
   uint32_t buffer_read_at_{0};
+  FastGPIO isr_pin_;
   void gpio_intr();
 #endif
 
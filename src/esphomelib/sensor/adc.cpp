@@ -94,10 +94,10 @@ void ADCSensorComponent::update() {
 
   this->publish_state(value_v);
 }
-std::string ADCSensorComponent::unit_of_measurement() {
+const char *ADCSensorComponent::unit_of_measurement() {
   return "V";
 }
-std::string ADCSensorComponent::icon() {
+const char *ADCSensorComponent::icon() {
   return "mdi:flash";
 }
 int8_t ADCSensorComponent::accuracy_decimals() {
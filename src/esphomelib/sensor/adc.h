@@ -47,9 +47,9 @@ class ADCSensorComponent : public PollingSensorComponent {
   void setup() override;
   void dump_config() override;
   /// Unit of measurement: "V".
-  std::string unit_of_measurement() override;
+  const char *unit_of_measurement() override;
   /// Icon: "mdi:flash".
-  std::string icon() override;
+  const char *icon() override;
   /// Accuracy decimals: 2.
   int8_t accuracy_decimals() override;
   /// `HARDWARE_LATE` setup priority.
@@ -12,8 +12,12 @@ namespace sensor {
 static const char *TAG = "sensor.ads1115";
 static const uint8_t ADS1115_REGISTER_CONVERSION = 0x00;
 static const uint8_t ADS1115_REGISTER_CONFIG = 0x01;
+static const uint8_t ADS1115_REGISTER_LO_THRESH = 0x02;
+static const uint8_t ADS1115_REGISTER_HI_THRESH = 0x03;
 
 static const uint8_t ADS1115_DATA_RATE_860_SPS = 0b111;
+/// Maximum time a single-shot conversion may take before we give up on it.
+static const uint32_t ADS1115_CONVERSION_TIMEOUT = 100;
 
 void ADS1115Component::setup() {
   ESP_LOGCONFIG(TAG, "Setting up ADS1115...");
@@ -22,23 +26,25 @@ void ADS1115Component::setup() {
     this->mark_failed();
     return;
   }
+  // A single sensor never needs to switch multiplexer/gain, so just let the ADS1115 convert continuously.
+  this->continuous_ = this->sensors_.size() == 1;
+
   uint16_t config = 0;
   // Clear single-shot bit
   //        0b0xxxxxxxxxxxxxxx
   config |= 0b0000000000000000;
   // Setup multiplexer
   //        0bx000xxxxxxxxxxxx
-  config |= ADS1115_MULTIPLEXER_P0_N1 << 12;
-
   // Setup Gain
   //        0bxxxx000xxxxxxxxx
-  config |= ADS1115_GAIN_6P144 << 9;
+  // (Both set per conversion, or below in continuous mode)
 
   // Set singleshot mode
   //        0bxxxxxxx1xxxxxxxx
-  config |= 0b0000000100000000;
+  if (!this->continuous_)
+    config |= 0b0000000100000000;
 
-  // Set data rate - 860 samples per second (we're in singleshot mode)
+  // Set data rate - 860 samples per second
   //        0bxxxxxxxx100xxxxx
   config |= ADS1115_DATA_RATE_860_SPS << 5;
 
@@ -54,17 +60,39 @@ void ADS1115Component::setup() {
   //        0bxxxxxxxxxxxxx0xx
   config |= 0b0000000000000000;
 
-  // Set comparator que mode - disabled
-  //        0bxxxxxxxxxxxxxx11
-  config |= 0b0000000000000011;
+  if (this->rdy_pin_ != nullptr && !this->continuous_) {
+    this->rdy_pin_->setup();
+    // Hi_thresh MSB=1 and Lo_thresh MSB=0 turn ALERT/RDY into a conversion ready output.
+    if (!this->write_byte_16(ADS1115_REGISTER_LO_THRESH, 0x0000) ||
+        !this->write_byte_16(ADS1115_REGISTER_HI_THRESH, 0x8000)) {
+      this->mark_failed();
+      return;
+    }
+    // Set comparator que mode - assert after one conversion
+    //        0bxxxxxxxxxxxxxx00
+    config |= 0b0000000000000000;
+  } else {
+    // Set comparator que mode - disabled
+    //        0bxxxxxxxxxxxxxx11
+    config |= 0b0000000000000011;
+  }
+  this->config_ = config;
+
+  if (this->continuous_) {
+    ADS1115Sensor *sensor = this->sensors_[0];
+    config |= (sensor->get_multiplexer() & 0b111) << 12;
+    config |= (sensor->get_gain() & 0b111) << 9;
+  }
 
   if (!this->write_byte_16(ADS1115_REGISTER_CONFIG, config)) {
     this->mark_failed();
     return;
   }
-  for (auto *sensor : this->sensors_) {
-    this->set_interval(sensor->get_name(), sensor->update_interval(), [this, sensor]{
-      this->request_measurement_(sensor);
+  this->requested_.resize(this->sensors_.size(), false);
+  for (uint8_t i = 0; i < this->sensors_.size(); i++) {
+    ADS1115Sensor *sensor = this->sensors_[i];
+    this->set_interval(sensor->get_name(), sensor->update_interval(), [this, i]{
+      this->request_measurement_(i);
     });
   }
 }
@@ -74,6 +102,8 @@ void ADS1115Component::dump_config() {
   if (this->is_failed()) {
     ESP_LOGE(TAG, "Communication with ADS1115 failed!");
   }
+  LOG_PIN("  ALERT/RDY Pin: ", this->rdy_pin_);
+  ESP_LOGCONFIG(TAG, "  Continuous Mode: %s", YESNO(this->continuous_));
 
   for (auto *sensor : this->sensors_) {
     LOG_SENSOR("  ", "Sensor", sensor);
@@ -81,45 +111,84 @@ void ADS1115Component::dump_config() {
     ESP_LOGCONFIG(TAG, "    Gain: %u", sensor->get_gain());
   }
 }
+void ADS1115Component::loop() {
+  if (this->active_sensor_ != nullptr) {
+    if (!this->conversion_done_()) {
+      if (millis() - this->conversion_start_ > ADS1115_CONVERSION_TIMEOUT) {
+        ESP_LOGW(TAG, "Reading ADS1115 timed out");
+        this->status_set_warning();
+        this->active_sensor_ = nullptr;
+      }
+      return;
+    }
+    this->read_conversion_(this->active_sensor_);
+    this->active_sensor_ = nullptr;
+  }
+
+  const uint8_t size = this->sensors_.size();
+  for (uint8_t i = 0; i < size; i++) {
+    const uint8_t index = (this->next_sensor_ + i) % size;
+    if (!this->requested_[index])
+      continue;
+
+    this->requested_[index] = false;
+    this->next_sensor_ = (index + 1) % size;
+    if (this->start_conversion_(this->sensors_[index]))
+      return;
+  }
+
+  // Nothing left to do, go back to the normal loop interval.
+  this->high_freq_.stop();
+}
 float ADS1115Component::get_setup_priority() const {
   return setup_priority::HARDWARE_LATE;
 }
-void ADS1115Component::request_measurement_(ADS1115Sensor *sensor) {
-  uint16_t config;
-  if (!this->read_byte_16(ADS1115_REGISTER_CONFIG, &config)) {
-    this->status_set_warning();
+void ADS1115Component::request_measurement_(uint8_t index) {
+  if (this->continuous_) {
+    // The conversion register always holds a fresh value (at most 1.2ms old).
+    this->read_conversion_(this->sensors_[index]);
     return;
   }
+
+  this->requested_[index] = true;
+  // Conversions only take about 1.2ms, don't wait a full loop interval for each of them.
+  this->high_freq_.start();
+}
+bool ADS1115Component::start_conversion_(ADS1115Sensor *sensor) {
+  uint16_t config = this->config_;
   // Multiplexer
   //        0bxBBBxxxxxxxxxxxx
-  config &= 0b1000111111111111;
   config |= (sensor->get_multiplexer() & 0b111) << 12;
 
   // Gain
   //        0bxxxxBBBxxxxxxxxx
-  config &= 0b1111000111111111;
   config |= (sensor->get_gain() & 0b111) << 9;
   // Start conversion
   config |= 0b1000000000000000;
 
   if (!this->write_byte_16(ADS1115_REGISTER_CONFIG, config)) {
     this->status_set_warning();
-    return;
+    return false;
   }
 
-  // about 1.6 ms with 860 samples per second
-  delay(2);
+  this->active_sensor_ = sensor;
+  this->conversion_start_ = millis();
+  return true;
+}
+bool ADS1115Component::conversion_done_() {
+  // about 1.2 ms with 860 samples per second, no need to check before that.
+  if (millis() - this->conversion_start_ < 2)
+    return false;
 
-  uint32_t start = millis();
-  while (this->read_byte_16(ADS1115_REGISTER_CONFIG, &config) && (config >> 15) == 0) {
-    if (millis() - start > 100) {
-      ESP_LOGW(TAG, "Reading ADS1115 timed out");
-      this->status_set_warning();
-      return;
-    }
-    yield();
-  }
+  if (this->rdy_pin_ != nullptr)
+    return !this->rdy_pin_->digital_read();
 
+  uint16_t config;
+  if (!this->read_byte_16(ADS1115_REGISTER_CONFIG, &config))
+    return false;
+  return (config >> 15) != 0;
+}
+void ADS1115Component::read_conversion_(ADS1115Sensor *sensor) {
   uint16_t raw_conversion;
   if (!this->read_byte_16(ADS1115_REGISTER_CONVERSION, &raw_conversion)) {
     this->status_set_warning();
@@ -151,6 +220,9 @@ ADS1115Sensor *ADS1115Component::get_sensor(const std::string &name, ADS1115Mult
   return s;
 }
 ADS1115Component::ADS1115Component(I2CComponent *parent, uint8_t address) : I2CDevice(parent, address) {}
+void ADS1115Component::set_rdy_pin(const GPIOInputPin &rdy_pin) {
+  this->rdy_pin_ = rdy_pin.copy();
+}
 
 uint8_t ADS1115Sensor::get_multiplexer() const {
   return this->multiplexer_;
@@ -7,6 +7,8 @@
 
 #include "esphomelib/sensor/sensor.h"
 #include "esphomelib/i2c_component.h"
+#include "esphomelib/esphal.h"
+#include "esphomelib/helpers.h"
 
 ESPHOMELIB_NAMESPACE_BEGIN
 
@@ -39,6 +41,11 @@ class ADS1115Sensor;
  * It is built of like the DallasComponent: A central hub (can be multiple ones) and multiple
  * Sensor instances that all access this central hub.
  *
+ * Measurements don't block the main loop: each sensor only queues a request, and the hub then starts
+ * the conversions round-robin from loop() and reads them out once they're ready. If the ALERT/RDY pin is
+ * connected, the end of a conversion is detected through it instead of polling the config register. With
+ * only a single sensor, the ADS1115 is put in continuous mode and the latest conversion is read directly.
+ *
  * Note that for this component to work correctly you need to have i2c setup. Do so with
  *
  * ```cpp
@@ -69,19 +76,44 @@ class ADS1115Component : public Component, public I2CDevice {
   ADS1115Sensor *get_sensor(const std::string &name, ADS1115Multiplexer multiplexer, ADS1115Gain gain,
                             uint32_t update_interval = 15000);
 
+  /** Set the pin the ALERT/RDY output of the ADS1115 is connected to.
+   *
+   * The pin is configured as a conversion ready signal, so that finished conversions can be detected
+   * without any I2C traffic.
+   *
+   * @param rdy_pin The pin, should usually be INPUT_PULLUP (ALERT/RDY is open-drain).
+   */
+  void set_rdy_pin(const GPIOInputPin &rdy_pin);
+
   // ========== INTERNAL METHODS ==========
   // (In most use cases you won't need these)
   /// Set up the internal sensor array.
   void setup() override;
   void dump_config() override;
+  /// Start queued conversions and read out finished ones.
+  void loop() override;
   /// HARDWARE_LATE setup priority
   float get_setup_priority() const override;
 
  protected:
-  /// Helper method to request a measurement from a sensor.
-  void request_measurement_(ADS1115Sensor *sensor);
+  /// Helper method to request a measurement from the sensor at index in sensors_.
+  void request_measurement_(uint8_t index);
+  /// Start a single-shot conversion for sensor.
+  bool start_conversion_(ADS1115Sensor *sensor);
+  /// Check whether the conversion that is in progress has finished.
+  bool conversion_done_();
+  /// Read the last conversion result and publish it to sensor.
+  void read_conversion_(ADS1115Sensor *sensor);
 
   std::vector<ADS1115Sensor *> sensors_;
+  std::vector<bool> requested_; ///< Which sensors are waiting for a conversion.
+  uint8_t next_sensor_{0}; ///< Round-robin position to start looking for requested sensors at.
+  ADS1115Sensor *active_sensor_{nullptr}; ///< The sensor the conversion in progress is for.
+  uint32_t conversion_start_{0};
+  uint16_t config_{0}; ///< The config register value without multiplexer and gain bits.
+  bool continuous_{false};
+  GPIOPin *rdy_pin_{nullptr};
+  HighFrequencyLoopRequester high_freq_;
 };
 
 /// Internal holder class that is in instance of Sensor so that the hub can create individual sensors.
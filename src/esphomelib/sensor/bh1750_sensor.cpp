@@ -67,10 +67,10 @@ void BH1750Sensor::update() {
     this->read_data_();
   });
 }
-std::string BH1750Sensor::unit_of_measurement() {
+const char *BH1750Sensor::unit_of_measurement() {
   return UNIT_LX;
 }
-std::string BH1750Sensor::icon() {
+const char *BH1750Sensor::icon() {
   return ICON_BRIGHTNESS_5;
 }
 int8_t BH1750Sensor::accuracy_decimals() {
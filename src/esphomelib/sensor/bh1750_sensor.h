@@ -43,8 +43,8 @@ class BH1750Sensor : public PollingSensorComponent, public I2CDevice {
   void dump_config() override;
   void update() override;
   float get_setup_priority() const override;
-  std::string unit_of_measurement() override;
-  std::string icon() override;
+  const char *unit_of_measurement() override;
+  const char *icon() override;
   int8_t accuracy_decimals() override;
 
  protected:
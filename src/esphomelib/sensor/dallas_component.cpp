@@ -5,6 +5,7 @@
 
 #ifdef USE_DALLAS_SENSOR
 
+#include <algorithm>
 #include "esphomelib/sensor/dallas_component.h"
 
 #include "esphomelib/helpers.h"
@@ -41,9 +42,7 @@ void DallasComponent::setup() {
   ESP_LOGCONFIG(TAG, "Setting up DallasComponent...");
 
   yield();
-  disable_interrupts();
   std::vector<uint64_t> raw_sensors = this->one_wire_->search_vec();
-  enable_interrupts();
 
   for (auto &address : raw_sensors) {
     std::string s = uint64_to_string(address);
@@ -61,7 +60,11 @@ void DallasComponent::setup() {
     this->found_sensors_.push_back(address);
   }
 
-  for (auto sensor : this->sensors_) {
+  this->setup_sensors_(0);
+}
+void DallasComponent::setup_sensors_(size_t start) {
+  for (size_t i = start; i < this->sensors_.size(); i++) {
+    DallasTemperatureSensor *sensor = this->sensors_[i];
     if (sensor->get_index().has_value()) {
       if (*sensor->get_index() >= this->found_sensors_.size()) {
         this->status_set_error();
@@ -72,8 +75,20 @@ void DallasComponent::setup() {
 
     if (!sensor->setup_sensor_()) {
       this->status_set_error();
+      continue;
+    }
+    if (sensor->write_resolution_()) {
+      // The bus must stay idle while the sensor copies its scratch pad to EEPROM (~10ms),
+      // so continue with the next sensor afterwards.
+      this->eeprom_write_pending_ = true;
+      this->set_timeout("eeprom", 20, [this, i]() {
+        this->one_wire_->reset();
+        this->setup_sensors_(i + 1);
+      });
+      return;
     }
   }
+  this->eeprom_write_pending_ = false;
 }
 void DallasComponent::dump_config() {
   ESP_LOGCONFIG(TAG, "DallasComponent:");
@@ -120,9 +135,13 @@ DallasTemperatureSensor *DallasComponent::get_sensor_by_index(const std::string
   return s;
 }
 void DallasComponent::update() {
+  if (this->eeprom_write_pending_) {
+    this->set_timeout("update", 20, [this]() { this->update(); });
+    return;
+  }
   this->status_clear_warning();
 
-  disable_interrupts();
+  // Broadcast a single "convert T" to all sensors on the bus.
   bool result;
   if (!this->one_wire_->reset()) {
     result = false;
@@ -131,7 +150,6 @@ void DallasComponent::update() {
     this->one_wire_->skip();
     this->one_wire_->write8(DALLAS_COMMAND_START_CONVERSION);
   }
-  enable_interrupts();
 
   if (!result) {
     ESP_LOGE(TAG, "Requesting conversion failed");
@@ -139,26 +157,30 @@ void DallasComponent::update() {
     return;
   }
 
-  for (auto *sensor : this->sensors_) {
-    this->set_timeout(sensor->get_address_name(), sensor->millis_to_wait_for_conversion_(), [this, sensor] {
-      disable_interrupts();
+  // All sensors convert in parallel, so wait for the one with the highest resolution.
+  uint16_t wait = 0;
+  for (auto *sensor : this->sensors_)
+    wait = std::max(wait, sensor->millis_to_wait_for_conversion_());
+
+  this->set_timeout("read", wait, [this] {
+    for (auto *sensor : this->sensors_) {
+      if (sensor->get_address() == 0)
+        // index-based sensor that wasn't found
+        continue;
+
       bool res = sensor->read_scratch_pad_();
-      enable_interrupts();
+      yield();
 
-      if (!res) {
-        this->status_set_warning();
-        return;
-      }
-      if (!sensor->check_scratch_pad_()) {
+      if (!res || !sensor->check_scratch_pad_()) {
         this->status_set_warning();
-        return;
+        continue;
       }
 
       float tempc = sensor->get_temp_c();
       ESP_LOGD(TAG, "'%s': Got Temperature=%.1f°C", sensor->get_name().c_str(), tempc);
       sensor->publish_state(tempc);
-    });
-  }
+    }
+  });
 }
 DallasComponent::DallasComponent(ESPOneWire *one_wire, uint32_t update_interval)
     : PollingComponent(update_interval), one_wire_(one_wire) {
@@ -218,56 +240,50 @@ bool DallasTemperatureSensor::read_scratch_pad_() {
   return true;
 }
 bool DallasTemperatureSensor::setup_sensor_() {
-  disable_interrupts();
-  bool r = this->read_scratch_pad_();
-  enable_interrupts();
-
-  if (!r) {
+  if (!this->read_scratch_pad_()) {
     ESP_LOGE(TAG, "Reading scratchpad failed: reset");
     return false;
   }
-  if (!this->check_scratch_pad_())
-    return false;
-
-  if (this->scratch_pad_[4] == this->resolution_)
-    return false;
-
+  return this->check_scratch_pad_();
+}
+bool DallasTemperatureSensor::write_resolution_() {
   if (this->get_address8()[0] == DALLAS_MODEL_DS18S20) {
     // DS18S20 doesn't support resolution.
     ESP_LOGW(TAG, "DS18S20 doesn't support setting resolution.");
     return false;
   }
 
+  uint8_t config;
   switch (this->resolution_) {
-    case 12:this->scratch_pad_[4] = 0x7F;
+    case 12:config = 0x7F;
       break;
-    case 11:this->scratch_pad_[4] = 0x5F;
+    case 11:config = 0x5F;
       break;
-    case 10:this->scratch_pad_[4] = 0x3F;
+    case 10:config = 0x3F;
       break;
     case 9:
-    default:this->scratch_pad_[4] = 0x1F;
+    default:config = 0x1F;
       break;
   }
+  // Only write (and wear the EEPROM) if the resolution actually changed.
+  if (this->scratch_pad_[4] == config)
+    return false;
+  this->scratch_pad_[4] = config;
 
   ESPOneWire *wire = this->parent_->get_one_wire();
-  disable_interrupts();
-  if (wire->reset()) {
-    wire->select(this->address_);
-    wire->write8(DALLAS_COMMAND_WRITE_SCRATCH_PAD);
-    wire->write8(this->scratch_pad_[2]); // high alarm temp
-    wire->write8(this->scratch_pad_[3]); // low alarm temp
-    wire->write8(this->scratch_pad_[4]); // resolution
-    wire->reset();
-
-    // write value to EEPROM
-    wire->select(this->address_);
-    wire->write8(0x48);
-  }
-  enable_interrupts();
+  if (!wire->reset())
+    return false;
 
-  delay(20);  // allow it to finish operation
+  wire->select(this->address_);
+  wire->write8(DALLAS_COMMAND_WRITE_SCRATCH_PAD);
+  wire->write8(this->scratch_pad_[2]); // high alarm temp
+  wire->write8(this->scratch_pad_[3]); // low alarm temp
+  wire->write8(this->scratch_pad_[4]); // resolution
   wire->reset();
+
+  // write value to EEPROM
+  wire->select(this->address_);
+  wire->write8(0x48);
   return true;
 }
 bool DallasTemperatureSensor::check_scratch_pad_() {
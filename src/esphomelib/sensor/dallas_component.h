@@ -60,9 +60,14 @@ class DallasComponent : public PollingComponent {
   ESPOneWire *get_one_wire() const;
 
  protected:
+  /// Set up the sensors from the given index on, pausing after each EEPROM write.
+  void setup_sensors_(size_t start);
+
   ESPOneWire *one_wire_;
   std::vector<DallasTemperatureSensor *> sensors_;
   std::vector<uint64_t> found_sensors_;
+  /// Set while the sensors copy a changed resolution to their EEPROM after setup.
+  bool eeprom_write_pending_{false};
 };
 
 /// Internal class that helps us create multiple sensors for one Dallas hub.
@@ -96,7 +101,10 @@ class DallasTemperatureSensor : public EmptyPollingParentSensor<1, ICON_EMPTY, U
   /// Get the number of milliseconds we have to wait for the conversion phase.
   uint16_t millis_to_wait_for_conversion_() const;
 
+  /// Read and check the scratch pad of this sensor.
   bool setup_sensor_();
+  /// Write the configured resolution to the sensor (and its EEPROM). Returns true if an EEPROM write was started.
+  bool write_resolution_();
   bool read_scratch_pad_();
 
   bool check_scratch_pad_();
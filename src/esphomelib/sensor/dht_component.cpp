@@ -17,6 +17,11 @@ ESPHOMELIB_NAMESPACE_BEGIN
 namespace sensor {
 
 static const char *TAG = "sensor.dht";
+/// Maximum duration of a frame after the start pulse (80+80µs response, 40*(50+70)µs bits, 50µs end).
+static const uint32_t DHT_FRAME_TIME = 6;
+
+/// All DHT components, linked through next_.
+static DHTComponent *dht_components = nullptr;
 
 DHTComponent::DHTComponent(const std::string &temperature_name, const std::string &humidity_name,
                            GPIOPin *pin, uint32_t update_interval)
@@ -30,6 +35,12 @@ void DHTComponent::setup() {
   ESP_LOGCONFIG(TAG, "Setting up DHT...");
   this->pin_->setup();
   this->pin_->digital_write(true);
+  this->isr_pin_ = this->pin_->to_fast_gpio();
+
+  disable_interrupts();
+  this->next_ = dht_components;
+  dht_components = this;
+  enable_interrupts();
 }
 void DHTComponent::dump_config() {
   ESP_LOGCONFIG(TAG, "DHT:");
@@ -49,20 +60,46 @@ void DHTComponent::dump_config() {
 }
 
 void DHTComponent::update() {
-  float temperature, humidity;
-  bool error;
-  if (this->model_ == DHT_MODEL_AUTO_DETECT) {
+  if (this->capturing_) {
+    ESP_LOGW(TAG, "Previous reading still in progress!");
+    return;
+  }
+
+  this->report_errors_ = this->model_ != DHT_MODEL_AUTO_DETECT;
+  if (this->model_ == DHT_MODEL_AUTO_DETECT)
     this->model_ = DHT_MODEL_DHT22;
-    error = this->read_sensor_(&temperature, &humidity, false);
-    if (error) {
-      this->model_ = DHT_MODEL_DHT11;
-      return;
-    }
-  } else {
-    error = this->read_sensor_(&temperature, &humidity, true);
+
+  this->pin_->pin_mode(OUTPUT);
+  this->pin_->digital_write(false);
+
+  // Start pulse, at least 18ms for the DHT11 and 800µs for the others.
+  const uint32_t start_time = this->model_ == DHT_MODEL_DHT11 ? 18 : 1;
+  this->set_timeout("start", start_time, [this]() { this->start_capture_(); });
+}
+void DHTComponent::start_capture_() {
+  this->edge_count_ = 0;
+  this->last_level_ = true;
+  // Attach the interrupt before releasing the bus: the sensor answers 20-40µs after the release, attaching
+  // can take longer than that. Our own rising edge is filtered by last_level_.
+  attachInterrupt(this->pin_->get_pin(), gpio_intr_, CHANGE);
+  this->pin_->pin_mode(INPUT_PULLUP);
+  this->capturing_ = true;
+
+  this->set_timeout("read", DHT_FRAME_TIME, [this]() { this->finish_capture_(); });
+}
+void DHTComponent::finish_capture_() {
+  detachInterrupt(this->pin_->get_pin());
+  this->capturing_ = false;
+
+  float temperature, humidity;
+  bool success = this->read_sensor_(&temperature, &humidity, this->report_errors_);
+  if (!success && !this->report_errors_) {
+    // Auto-detection: DHT22 timing didn't work, use the DHT11 start pulse from now on.
+    this->model_ = DHT_MODEL_DHT11;
+    return;
   }
 
-  if (error) {
+  if (success) {
     ESP_LOGD(TAG, "Got Temperature=%.1f°C Humidity=%.1f%%", temperature, humidity);
 
     this->temperature_sensor_->publish_state(temperature);
@@ -77,6 +114,46 @@ void DHTComponent::update() {
     this->status_set_warning();
   }
 }
+void ICACHE_RAM_ATTR HOT DHTComponent::gpio_intr_() {
+  DHTComponent *component = dht_components;
+  while (component != nullptr) {
+    component->on_interrupt_();
+    component = component->next_;
+  }
+}
+void ICACHE_RAM_ATTR HOT DHTComponent::on_interrupt_() {
+  if (!this->capturing_)
+    return;
+  const bool level = this->isr_pin_.digital_read();
+  // The handler is shared, only record edges on our own pin.
+  if (level == this->last_level_)
+    return;
+  this->last_level_ = level;
+
+  const uint8_t count = this->edge_count_;
+  if (count >= DHT_MAX_EDGES)
+    return;
+  this->edges_[count] = static_cast<uint16_t>(micros());
+  this->edge_count_ = count + 1;
+}
+uint8_t DHTComponent::decode_edges(const uint16_t *edges, uint8_t count, uint8_t *data) {
+  for (uint8_t i = 0; i < 5; i++)
+    data[i] = 0;
+
+  // edges[0..2] are the sensor's response (80µs low, 80µs high), after that each bit is a ~50µs low
+  // pulse followed by a high pulse of ~26µs (0) or ~70µs (1).
+  uint8_t bits = 0;
+  for (; bits < 40; bits++) {
+    const uint8_t rising = 3 + bits * 2;
+    const uint8_t falling = rising + 1;
+    if (falling >= count)
+      break;
+    const uint16_t high_time = edges[falling] - edges[rising];
+    if (high_time >= 40)
+      data[bits / 8] |= 1 << (7 - bits % 8);
+  }
+  return bits;
+}
 
 float DHTComponent::get_setup_priority() const {
   return setup_priority::HARDWARE_LATE;
@@ -91,75 +168,27 @@ DHTTemperatureSensor *DHTComponent::get_temperature_sensor() const {
 DHTHumiditySensor *DHTComponent::get_humidity_sensor() const {
   return this->humidity_sensor_;
 }
-bool HOT DHTComponent::read_sensor_(float *temperature, float *humidity, bool report_errors) {
+bool DHTComponent::read_sensor_(float *temperature, float *humidity, bool report_errors) {
   *humidity = NAN;
   *temperature = NAN;
 
-  disable_interrupts();
-  this->pin_->pin_mode(OUTPUT);
-  this->pin_->digital_write(false);
-
-  if (this->model_ == DHT_MODEL_DHT11)
-    delayMicroseconds(18000);
-  else
-    delayMicroseconds(800);
+  uint16_t edges[DHT_MAX_EDGES];
+  const uint8_t count = this->edge_count_;
+  for (uint8_t i = 0; i < count; i++)
+    edges[i] = this->edges_[i];
 
-  this->pin_->pin_mode(INPUT_PULLUP);
-  delayMicroseconds(40);
-
-  uint8_t data[5] = {0, 0, 0, 0, 0};
-  uint8_t bit = 7;
-  uint8_t byte = 0;
-
-  for (int8_t i = -1; i < 40; i++) {
-    uint32_t start_time = micros();
-
-    // Wait for rising edge
-    while (!this->pin_->digital_read()) {
-      if (micros() - start_time > 90) {
-        enable_interrupts();
-        if (report_errors) {
-          if (i < 0) {
-            ESP_LOGW(TAG, "Waiting for DHT communication to clear failed!");
-          } else {
-            ESP_LOGW(TAG, "Rising edge for bit %d failed!", i);
-          }
-        }
-        return false;
-      }
-    }
-
-    start_time = micros();
-    uint32_t end_time = start_time;
-
-    // Wait for falling edge
-    while (this->pin_->digital_read()) {
-      if ((end_time = micros()) - start_time > 90) {
-        enable_interrupts();
-        if (report_errors) {
-          if (i < 0) {
-            ESP_LOGW(TAG, "Requesting data from DHT failed!");
-          } else {
-            ESP_LOGW(TAG, "Falling edge for bit %d failed!", i);
-          }
-        }
-        return false;
+  uint8_t data[5];
+  const uint8_t bits = decode_edges(edges, count, data);
+  if (bits < 40) {
+    if (report_errors) {
+      if (count < 3) {
+        ESP_LOGW(TAG, "Requesting data from DHT failed!");
+      } else {
+        ESP_LOGW(TAG, "Receiving bit %u failed!", bits);
       }
     }
-
-    if (i < 0)
-      continue;
-
-    if (end_time - start_time >= 40) {
-      data[byte] |= 1 << bit;
-    }
-    if (bit == 0) {
-      bit = 7;
-      byte++;
-    }
-    else bit--;
+    return false;
   }
-  enable_interrupts();
 
   ESP_LOGVV(TAG, "Data: Hum=0b" BYTE_TO_BINARY_PATTERN BYTE_TO_BINARY_PATTERN ", Temp=0b" BYTE_TO_BINARY_PATTERN BYTE_TO_BINARY_PATTERN ", Checksum=0b" BYTE_TO_BINARY_PATTERN,
             BYTE_TO_BINARY(data[0]), BYTE_TO_BINARY(data[1]),
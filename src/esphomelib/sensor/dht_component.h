@@ -6,6 +6,7 @@
 #ifdef USE_DHT_SENSOR
 
 #include "esphomelib/sensor/sensor.h"
+#include "esphomelib/esphal.h"
 
 ESPHOMELIB_NAMESPACE_BEGIN
 
@@ -22,7 +23,14 @@ enum DHTModel {
   DHT_MODEL_RHT03,
 };
 
-/// Component for reading temperature/humidity measurements from DHT11/DHT22 sensors.
+/// The number of edges of a complete DHT frame: response (3), 40 bits (2 each) and the final release (1).
+static const uint8_t DHT_MAX_EDGES = 84;
+
+/** Component for reading temperature/humidity measurements from DHT11/DHT22 sensors.
+ *
+ * Readings don't block: the start pulse is ended by a timeout, the edges of the sensor's response are
+ * timestamped by a pin interrupt, and the frame is decoded from those timings in the main loop.
+ */
 class DHTComponent : public PollingComponent {
  public:
   /** Construct a DHTComponent.
@@ -55,15 +63,39 @@ class DHTComponent : public PollingComponent {
   /// Set up the pins and check connection.
   void setup() override;
   void dump_config() override;
-  /// Update sensor values and push them to the frontend.
+  /// Send the start pulse, the values are pushed to the frontend once the response has been received.
   void update() override;
   /// HARDWARE_LATE setup priority.
   float get_setup_priority() const override;
 
+  /** Decode a DHT frame from the timestamps of its edges.
+   *
+   * @param edges Timestamps in µs (truncated to 16 bits) of the edges following the start pulse, alternating
+   *              between falling and rising edges, starting with the falling edge of the sensor's response.
+   * @param count The number of edges.
+   * @param data The 5 decoded bytes.
+   * @return The number of bits that could be decoded (40 for a complete frame).
+   */
+  static uint8_t decode_edges(const uint16_t *edges, uint8_t count, uint8_t *data);
+
  protected:
+  /// Release the bus after the start pulse and start capturing edges.
+  void start_capture_();
+  /// Stop capturing, decode the frame and publish the values.
+  void finish_capture_();
   bool read_sensor_(float *temperature, float *humidity, bool report_errors);
 
+  void on_interrupt_();
+  static void gpio_intr_();
+
   GPIOPin *pin_;
+  FastGPIO isr_pin_;
+  volatile uint16_t edges_[DHT_MAX_EDGES];
+  volatile uint8_t edge_count_{0};
+  volatile bool capturing_{false};
+  volatile bool last_level_{true};
+  bool report_errors_{true};
+  DHTComponent *next_{nullptr};
   DHTModel model_{DHT_MODEL_AUTO_DETECT};
   bool is_auto_detect_{false};
   DHTTemperatureSensor *temperature_sensor_;
@@ -28,6 +28,7 @@ void ICACHE_RAM_ATTR HOT DutyCycleSensor::gpio_intr() {
 void DutyCycleSensor::setup() {
   ESP_LOGCONFIG(TAG, "Setting up Duty Cycle Sensor '%s'...", this->get_name().c_str());
   this->pin_->setup();
+  this->isr_pin_ = this->pin_->to_fast_gpio();
   this->last_level_ = this->pin_->digital_read();
 
   disable_interrupts();
@@ -50,7 +51,7 @@ void DutyCycleSensor::dump_config() {
   LOG_UPDATE_INTERVAL(this);
 }
 void ICACHE_RAM_ATTR HOT DutyCycleSensor::on_interrupt() {
-  const bool new_level = this->pin_->digital_read();
+  const bool new_level = this->isr_pin_.digital_read();
   if (new_level == this->last_level_)
     return;
   this->last_level_ = new_level;
@@ -80,10 +81,10 @@ void DutyCycleSensor::update() {
   this->last_interrupt_ = now;
 }
 
-std::string DutyCycleSensor::unit_of_measurement() {
+const char *DutyCycleSensor::unit_of_measurement() {
   return "%";
 }
-std::string DutyCycleSensor::icon() {
+const char *DutyCycleSensor::icon() {
   return "mdi:percent";
 }
 int8_t DutyCycleSensor::accuracy_decimals() {
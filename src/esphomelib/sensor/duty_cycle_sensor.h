@@ -19,8 +19,8 @@ class DutyCycleSensor : public PollingSensorComponent {
   float get_setup_priority() const override;
   void dump_config() override;
   void update() override;
-  std::string unit_of_measurement() override;
-  std::string icon() override;
+  const char *unit_of_measurement() override;
+  const char *icon() override;
   int8_t accuracy_decimals() override;
 
   void on_interrupt();
@@ -29,6 +29,7 @@ class DutyCycleSensor : public PollingSensorComponent {
 
  protected:
   GPIOPin *pin_;
+  FastGPIO isr_pin_;
   volatile uint32_t last_interrupt_{0};
   volatile uint32_t on_time_{0};
   volatile bool last_level_{false};
@@ -21,10 +21,10 @@ void ESP32HallSensor::update() {
   ESP_LOGCONFIG(TAG, "'%s': Got reading %.0f µT", this->name_.c_str(), value);
   this->publish_state(value);
 }
-std::string ESP32HallSensor::unit_of_measurement() {
+const char *ESP32HallSensor::unit_of_measurement() {
   return "µT";
 }
-std::string ESP32HallSensor::icon() {
+const char *ESP32HallSensor::icon() {
   return "mdi:magnet";
 }
 int8_t ESP32HallSensor::accuracy_decimals() {
@@ -0,0 +1,82 @@
+#include "esphomelib/defines.h"
+
+#ifdef USE_HEAP_SENSOR
+
+#include "esphomelib/sensor/heap_sensor.h"
+#include "esphomelib/heap_tracker.h"
+#include "esphomelib/log.h"
+#ifdef USE_HEAP_TRACKER
+  #include "esphomelib/application.h"
+#endif
+
+ESPHOMELIB_NAMESPACE_BEGIN
+
+namespace sensor {
+
+static const char *TAG = "sensor.heap";
+
+HeapSensor::HeapSensor(const std::string &name, uint32_t update_interval)
+    : PollingSensorComponent(name, update_interval) {
+
+}
+HeapLargestBlockSensor *HeapSensor::make_largest_block_sensor(const std::string &name) {
+  return this->largest_block_sensor_ = new HeapLargestBlockSensor(name, this);
+}
+HeapFragmentationSensor *HeapSensor::make_fragmentation_sensor(const std::string &name) {
+  return this->fragmentation_sensor_ = new HeapFragmentationSensor(name, this);
+}
+#ifdef USE_HEAP_TRACKER
+HeapAllocationRateSensor *HeapSensor::make_allocation_rate_sensor(const std::string &name) {
+  return this->allocation_rate_sensor_ = new HeapAllocationRateSensor(name, this);
+}
+#endif
+void HeapSensor::update() {
+  const uint32_t free_heap = ESP.getFreeHeap();
+  ESP_LOGD(TAG, "Free heap: %u bytes", free_heap);
+  this->publish_state(free_heap);
+
+  if (this->largest_block_sensor_ != nullptr)
+    this->largest_block_sensor_->publish_state(heap_largest_free_block());
+  if (this->fragmentation_sensor_ != nullptr)
+    this->fragmentation_sensor_->publish_state(heap_fragmentation());
+
+#ifdef USE_HEAP_TRACKER
+  const uint32_t now = millis();
+  const uint32_t allocations = heap_tracker_total_allocations();
+  if (this->allocation_rate_sensor_ != nullptr && this->last_update_ != 0 && now != this->last_update_) {
+    float rate = (allocations - this->last_allocations_) * 60000.0f / (now - this->last_update_);
+    this->allocation_rate_sensor_->publish_state(rate);
+  }
+  this->last_allocations_ = allocations;
+  this->last_update_ = now;
+
+  App.dump_heap_stats();
+#endif
+}
+void HeapSensor::dump_config() {
+  LOG_SENSOR("", "Heap Sensor", this);
+  LOG_UPDATE_INTERVAL(this);
+  LOG_SENSOR("  ", "Largest Free Block", this->largest_block_sensor_);
+  LOG_SENSOR("  ", "Fragmentation", this->fragmentation_sensor_);
+#ifdef USE_HEAP_TRACKER
+  LOG_SENSOR("  ", "Allocation Rate", this->allocation_rate_sensor_);
+#endif
+}
+const char *HeapSensor::unit_of_measurement() {
+  return UNIT_BYTES;
+}
+const char *HeapSensor::icon() {
+  return ICON_MEMORY;
+}
+int8_t HeapSensor::accuracy_decimals() {
+  return 0;
+}
+float HeapSensor::get_setup_priority() const {
+  return setup_priority::HARDWARE;
+}
+
+} // namespace sensor
+
+ESPHOMELIB_NAMESPACE_END
+
+#endif //USE_HEAP_SENSOR
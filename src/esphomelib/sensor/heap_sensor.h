@@ -0,0 +1,60 @@
+#ifndef ESPHOMELIB_SENSOR_HEAP_SENSOR_H
+#define ESPHOMELIB_SENSOR_HEAP_SENSOR_H
+
+#include "esphomelib/defines.h"
+
+#ifdef USE_HEAP_SENSOR
+
+#include "esphomelib/sensor/sensor.h"
+
+ESPHOMELIB_NAMESPACE_BEGIN
+
+namespace sensor {
+
+class HeapSensor;
+
+using HeapLargestBlockSensor = EmptyPollingParentSensor<0, ICON_MEMORY, UNIT_BYTES, HeapSensor>;
+using HeapFragmentationSensor = EmptyPollingParentSensor<0, ICON_MEMORY, UNIT_PERCENT, HeapSensor>;
+using HeapAllocationRateSensor = EmptyPollingParentSensor<0, ICON_MEMORY, UNIT_ALLOCATIONS_PER_MINUTE, HeapSensor>;
+
+/** Report the free heap size, and optionally the largest free block and the fragmentation of the heap.
+ *
+ * With USE_HEAP_TRACKER, the allocation rate sensor reports how many operator new allocations were made
+ * per minute, and every update logs the allocation statistics of all components.
+ */
+class HeapSensor : public PollingSensorComponent {
+ public:
+  explicit HeapSensor(const std::string &name, uint32_t update_interval = 60000);
+
+  HeapLargestBlockSensor *make_largest_block_sensor(const std::string &name);
+  HeapFragmentationSensor *make_fragmentation_sensor(const std::string &name);
+#ifdef USE_HEAP_TRACKER
+  HeapAllocationRateSensor *make_allocation_rate_sensor(const std::string &name);
+#endif
+
+  void update() override;
+  void dump_config() override;
+
+  const char *unit_of_measurement() override;
+  const char *icon() override;
+  int8_t accuracy_decimals() override;
+
+  float get_setup_priority() const override;
+
+ protected:
+  HeapLargestBlockSensor *largest_block_sensor_{nullptr};
+  HeapFragmentationSensor *fragmentation_sensor_{nullptr};
+#ifdef USE_HEAP_TRACKER
+  HeapAllocationRateSensor *allocation_rate_sensor_{nullptr};
+  uint32_t last_allocations_{0};
+  uint32_t last_update_{0};
+#endif
+};
+
+} // namespace sensor
+
+ESPHOMELIB_NAMESPACE_END
+
+#endif //USE_HEAP_SENSOR
+
+#endif //ESPHOMELIB_SENSOR_HEAP_SENSOR_H
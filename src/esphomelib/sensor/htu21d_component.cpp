@@ -17,8 +17,11 @@ namespace sensor {
 static const char *TAG = "sensor.htu21d";
 static const uint8_t HTU21D_ADDRESS = 0x40;
 static const uint8_t HTU21D_REGISTER_RESET = 0xFE;
-static const uint8_t HTU21D_REGISTER_TEMPERATURE = 0xE3;
-static const uint8_t HTU21D_REGISTER_HUMIDITY = 0xE5;
+// "No Hold Master" variants, the sensor NACKs reads until the measurement is done instead of stretching the clock.
+static const uint8_t HTU21D_REGISTER_TEMPERATURE = 0xF3;
+static const uint8_t HTU21D_REGISTER_HUMIDITY = 0xF5;
+/// Maximum measurement time (14-bit temperature), also used for the 12-bit humidity measurement.
+static const uint32_t HTU21D_CONVERSION_TIME = 50;
 static const uint8_t HTU21D_REGISTER_STATUS = 0xE7;
 
 HTU21DComponent::HTU21DComponent(I2CComponent *parent,
@@ -38,7 +41,8 @@ void HTU21DComponent::setup() {
   }
 
   // Wait for software reset to complete
-  delay(15);
+  this->resetting_ = true;
+  this->set_timeout("reset", 15, [this]() { this->resetting_ = false; });
 }
 void HTU21DComponent::dump_config() {
   ESP_LOGCONFIG(TAG, "HTU21D:");
@@ -51,26 +55,43 @@ void HTU21DComponent::dump_config() {
   LOG_SENSOR("  ", "Humidity", this->humidity_);
 }
 void HTU21DComponent::update() {
-  uint16_t raw_temperature;
-  if (!this->read_byte_16(HTU21D_REGISTER_TEMPERATURE, &raw_temperature, 50)) {
-    this->status_set_warning();
+  if (this->resetting_) {
+    this->set_timeout("update", 15, [this]() { this->update(); });
     return;
   }
 
-  float temperature = (float(raw_temperature & 0xFFFC)) * 175.72f / 65536.0f - 46.85f;
-
-  uint16_t raw_humidity;
-  if (!this->read_byte_16(HTU21D_REGISTER_HUMIDITY, &raw_humidity, 50)) {
+  if (!this->write_bytes(HTU21D_REGISTER_TEMPERATURE, nullptr, 0)) {
     this->status_set_warning();
     return;
   }
 
-  float humidity = (float(raw_humidity & 0xFFFC)) * 125.0f / 65536.0f - 6.0f;
-  ESP_LOGD(TAG, "Got Temperature=%.1f°C Humidity=%.1f%%", temperature, humidity);
-
-  this->temperature_->publish_state(temperature);
-  this->humidity_->publish_state(humidity);
-  this->status_clear_warning();
+  this->set_timeout("temperature", HTU21D_CONVERSION_TIME, [this]() {
+    uint16_t raw_temperature;
+    if (!this->parent_->receive_16_(this->address_, &raw_temperature, 1)) {
+      this->status_set_warning();
+      return;
+    }
+    float temperature = (float(raw_temperature & 0xFFFC)) * 175.72f / 65536.0f - 46.85f;
+
+    if (!this->write_bytes(HTU21D_REGISTER_HUMIDITY, nullptr, 0)) {
+      this->status_set_warning();
+      return;
+    }
+
+    this->set_timeout("humidity", HTU21D_CONVERSION_TIME, [this, temperature]() {
+      uint16_t raw_humidity;
+      if (!this->parent_->receive_16_(this->address_, &raw_humidity, 1)) {
+        this->status_set_warning();
+        return;
+      }
+      float humidity = (float(raw_humidity & 0xFFFC)) * 125.0f / 65536.0f - 6.0f;
+      ESP_LOGD(TAG, "Got Temperature=%.1f°C Humidity=%.1f%%", temperature, humidity);
+
+      this->temperature_->publish_state(temperature);
+      this->humidity_->publish_state(humidity);
+      this->status_clear_warning();
+    });
+  });
 }
 HTU21DTemperatureSensor *HTU21DComponent::get_temperature_sensor() const {
   return this->temperature_;
@@ -46,6 +46,7 @@ class HTU21DComponent : public PollingComponent, public I2CDevice {
  protected:
   HTU21DTemperatureSensor *temperature_{nullptr};
   HTU21DHumiditySensor *humidity_{nullptr};
+  bool resetting_{false};
 };
 
 } // namespace sensor
@@ -15,6 +15,8 @@ void HX711Sensor::setup() {
   ESP_LOGCONFIG(TAG, "Setting up HX711 '%s'...", this->name_.c_str());
   this->sck_pin_->setup();
   this->dout_pin_->setup();
+  this->sck_fast_ = this->sck_pin_->to_fast_gpio();
+  this->dout_fast_ = this->dout_pin_->to_fast_gpio();
 
   // Read sensor once without publishing to set the gain
   this->read_sensor_(nullptr);
@@ -47,17 +49,17 @@ bool HX711Sensor::read_sensor_(uint32_t *result) {
   uint32_t data = 0;
 
   for (uint8_t i = 0; i < 24; i++) {
-    this->sck_pin_->digital_write(true);
+    this->sck_fast_.digital_write(true);
     delayMicroseconds(1);
-    data |= uint32_t(this->dout_pin_->digital_read()) << (24 - i);
-    this->sck_pin_->digital_write(false);
+    data |= uint32_t(this->dout_fast_.digital_read()) << (24 - i);
+    this->sck_fast_.digital_write(false);
     delayMicroseconds(1);
   }
 
   // Cycle clock pin for gain setting
   for (uint8_t i = 0; i < this->gain_; i++) {
-    this->sck_pin_->digital_write(true);
-    this->sck_pin_->digital_write(false);
+    this->sck_fast_.digital_write(true);
+    this->sck_fast_.digital_write(false);
   }
 
   data ^= 0x800000;
@@ -65,11 +67,11 @@ bool HX711Sensor::read_sensor_(uint32_t *result) {
     *result = data;
   return true;
 }
-std::string HX711Sensor::unit_of_measurement() {
+const char *HX711Sensor::unit_of_measurement() {
   // datasheet gives no unit
   return "";
 }
-std::string HX711Sensor::icon() {
+const char *HX711Sensor::icon() {
   return "mdi:scale";
 }
 int8_t HX711Sensor::accuracy_decimals() {
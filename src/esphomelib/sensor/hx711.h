@@ -28,8 +28,8 @@ class HX711Sensor : public PollingSensorComponent {
 
   void set_gain(HX711Gain gain);
 
-  std::string unit_of_measurement() override;
-  std::string icon() override;
+  const char *unit_of_measurement() override;
+  const char *icon() override;
   int8_t accuracy_decimals() override;
 
  protected:
@@ -37,6 +37,8 @@ class HX711Sensor : public PollingSensorComponent {
 
   GPIOPin *dout_pin_;
   GPIOPin *sck_pin_;
+  FastGPIO dout_fast_;
+  FastGPIO sck_fast_;
   HX711Gain gain_{HX711_GAIN_128};
 };
 
@@ -33,8 +33,10 @@ void INA3221Component::setup() {
     this->mark_failed();
     return;
   }
-  delay(1);
-
+  // Let the reset complete before writing the actual configuration.
+  this->set_timeout("config", 1, [this]() { this->write_config_(); });
+}
+void INA3221Component::write_config_() {
   uint16_t config = 0;
   // 0b0xxx000000000000 << 12 Channel Enables (1 -> ON)
   if (this->channels[0].exists()) {
@@ -58,6 +60,7 @@ void INA3221Component::setup() {
     this->mark_failed();
     return;
   }
+  this->configured_ = true;
 }
 
 void INA3221Component::dump_config() {
@@ -91,12 +94,17 @@ inline uint8_t ina3221_shunt_voltage_register(int channel) {
 }
 
 void INA3221Component::update() {
+  if (!this->configured_) {
+    this->set_timeout("update", 1, [this]() { this->update(); });
+    return;
+  }
+
   for (int i = 0; i < 3; i++) {
     INA3221Channel &channel = this->channels[i];
     float bus_voltage_v = NAN, current_a = NAN;
     uint16_t raw;
     if (channel.should_measure_bus_voltage()) {
-      if (!this->read_byte_16(ina3221_bus_voltage_register(i), &raw, 1)) {
+      if (!this->read_byte_16(ina3221_bus_voltage_register(i), &raw)) {
         this->status_set_warning();
         return;
       }
@@ -105,7 +113,7 @@ void INA3221Component::update() {
         channel.bus_voltage_sensor_->publish_state(bus_voltage_v);
     }
     if (channel.should_measure_shunt_voltage()) {
-      if (!this->read_byte_16(ina3221_shunt_voltage_register(i), &raw, 1)) {
+      if (!this->read_byte_16(ina3221_shunt_voltage_register(i), &raw)) {
         this->status_set_warning();
         return;
       }
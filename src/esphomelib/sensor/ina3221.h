@@ -42,6 +42,11 @@ class INA3221Component : public PollingComponent, public I2CDevice {
     bool should_measure_shunt_voltage();
     bool should_measure_bus_voltage();
   } channels[3];
+
+  /// Second setup stage, write the configuration once the reset has completed.
+  void write_config_();
+
+  bool configured_{false};
 };
 
 } // namespace sensor
@@ -15,7 +15,8 @@ static const char *TAG = "sensor.max31855";
 
 void MAX31855Sensor::update() {
   this->enable();
-  delay(1);
+  // CS only needs to be low for t_CSS (100ns) to stop the running conversion.
+  delayMicroseconds(1);
   // conversion initiated by rising edge
   this->disable();
 
@@ -36,10 +37,10 @@ void MAX31855Sensor::dump_config() {
 float MAX31855Sensor::get_setup_priority() const {
   return setup_priority::HARDWARE_LATE;
 }
-std::string MAX31855Sensor::unit_of_measurement() {
+const char *MAX31855Sensor::unit_of_measurement() {
   return UNIT_C;
 }
-std::string MAX31855Sensor::icon() {
+const char *MAX31855Sensor::icon() {
   return ICON_EMPTY;
 }
 int8_t MAX31855Sensor::accuracy_decimals() {
@@ -47,7 +48,7 @@ int8_t MAX31855Sensor::accuracy_decimals() {
 }
 void MAX31855Sensor::read_data_() {
   this->enable();
-  delay(1);
+  delayMicroseconds(1);
   uint8_t data[4];
   this->read_array(data, 4);
 
@@ -36,10 +36,10 @@ void MAX6675Sensor::dump_config() {
 float MAX6675Sensor::get_setup_priority() const {
   return setup_priority::HARDWARE_LATE;
 }
-std::string MAX6675Sensor::unit_of_measurement() {
+const char *MAX6675Sensor::unit_of_measurement() {
   return UNIT_C;
 }
-std::string MAX6675Sensor::icon() {
+const char *MAX6675Sensor::icon() {
   return ICON_EMPTY;
 }
 int8_t MAX6675Sensor::accuracy_decimals() {
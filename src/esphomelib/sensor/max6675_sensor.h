@@ -22,8 +22,8 @@ class MAX6675Sensor : public PollingSensorComponent, public SPIDevice {
 
   void update() override;
 
-  std::string unit_of_measurement() override;
-  std::string icon() override;
+  const char *unit_of_measurement() override;
+  const char *icon() override;
   int8_t accuracy_decimals() override;
 
  protected:
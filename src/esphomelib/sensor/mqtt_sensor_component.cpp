@@ -54,14 +54,16 @@ std::string MQTTSensorComponent::friendly_name() const {
   return this->sensor_->get_name();
 }
 void MQTTSensorComponent::send_discovery(JsonObject &root, mqtt::SendDiscoveryConfig &config) {
-  if (!this->sensor_->get_unit_of_measurement().empty())
-    root["unit_of_measurement"] = this->sensor_->get_unit_of_measurement();
+  const char *unit_of_measurement = this->sensor_->get_unit_of_measurement();
+  if (unit_of_measurement[0] != '\0')
+    root["unit_of_measurement"] = unit_of_measurement;
 
   if (this->get_expire_after() > 0)
     root["expire_after"] = this->get_expire_after() / 1000;
 
-  if (!this->sensor_->get_icon().empty())
-    root["icon"] = this->sensor_->get_icon();
+  const char *icon = this->sensor_->get_icon();
+  if (icon[0] != '\0')
+    root["icon"] = icon;
 
   config.command_topic = false;
 }
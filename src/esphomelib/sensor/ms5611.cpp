@@ -24,13 +24,16 @@ void MS5611Component::setup() {
     this->mark_failed();
     return;
   }
-  delay(100);
-  for (uint8_t offset = 0; offset < 6; offset++) {
-    if (!this->read_byte_16(MS5611_CMD_READ_PROM + (offset * 2), &this->prom[offset])) {
-      this->mark_failed();
-      return;
+  // Wait for the reset to complete (and the PROM to be reloaded) without blocking the loop.
+  this->set_timeout("prom", 100, [this]() {
+    for (uint8_t offset = 0; offset < 6; offset++) {
+      if (!this->read_byte_16(MS5611_CMD_READ_PROM + (offset * 2), &this->prom[offset])) {
+        this->mark_failed();
+        return;
+      }
     }
-  }
+    this->prom_read_ = true;
+  });
 }
 void MS5611Component::dump_config() {
   ESP_LOGCONFIG(TAG, "MS5611:");
@@ -46,6 +49,12 @@ float MS5611Component::get_setup_priority() const {
   return setup_priority::HARDWARE_LATE;
 }
 void MS5611Component::update() {
+  if (!this->prom_read_) {
+    // Calibration data not there yet, try again once the PROM has been read.
+    this->set_timeout("update", 10, [this]() { this->update(); });
+    return;
+  }
+
   // request temperature reading
   if (!this->write_bytes(MS5611_CMD_CONV_D2 + 0x08, nullptr, 0)) {
     this->status_set_warning();
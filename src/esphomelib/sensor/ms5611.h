@@ -36,6 +36,7 @@ class MS5611Component : public PollingComponent, public I2CDevice {
   MS5611TemperatureSensor *temperature_sensor_;
   MS5611PressureSensor *pressure_sensor_;
   uint16_t prom[6];
+  bool prom_read_{false};
 };
 
 } // namespace sensor
@@ -182,7 +182,7 @@ void PMSX003Component::dump_config() {
   LOG_SENSOR("  ", "Formaldehyde", this->formaldehyde_sensor_);
 }
 
-std::string PMSX003Sensor::unit_of_measurement() {
+const char *PMSX003Sensor::unit_of_measurement() {
   switch (this->type_) {
     case PMSX003_SENSOR_TYPE_PM_1_0:
     case PMSX003_SENSOR_TYPE_PM_2_5:
@@ -196,7 +196,7 @@ std::string PMSX003Sensor::unit_of_measurement() {
   }
   return "";
 }
-std::string PMSX003Sensor::icon() {
+const char *PMSX003Sensor::icon() {
   switch (this->type_) {
     case PMSX003_SENSOR_TYPE_PM_1_0:
     case PMSX003_SENSOR_TYPE_PM_2_5:
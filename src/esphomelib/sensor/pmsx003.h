@@ -39,8 +39,8 @@ class PMSX003Sensor : public sensor::Sensor {
  public:
   PMSX003Sensor(const std::string &name, PMSX003SensorType type);
 
-  std::string unit_of_measurement() override;
-  std::string icon() override;
+  const char *unit_of_measurement() override;
+  const char *icon() override;
   int8_t accuracy_decimals() override;
 
  protected:
@@ -7,21 +7,26 @@
 #include "esphomelib/log.h"
 #include "esphomelib/esphal.h"
 #include "esphomelib/espmath.h"
+#include "esphomelib/helpers.h"
 
 #ifdef ARDUINO_ARCH_ESP8266
   #include "FunctionalInterrupt.h"
 #endif
+#ifdef ARDUINO_ARCH_ESP32
+  #include <soc/pcnt_struct.h>
+#endif
 
 ESPHOMELIB_NAMESPACE_BEGIN
 
 namespace sensor {
 
 static const char *TAG = "sensor.pulse_counter";
+/// Minimum time between two saves of the total to the preferences.
+static const uint32_t PULSE_COUNTER_SAVE_INTERVAL = 60000;
 
 PulseCounterBase::PulseCounterBase(GPIOPin *pin) : pin_(pin) {
 #ifdef ARDUINO_ARCH_ESP32
-  this->pcnt_unit_ = next_pcnt_unit;
-  next_pcnt_unit = pcnt_unit_t(int(next_pcnt_unit) + 1); // NOLINT
+  this->pcnt_unit_ = select_next_pcnt_unit();
 #endif
 }
 
@@ -42,27 +47,79 @@ GPIOPin *PulseCounterBase::get_pin() {
   return this->pin_;
 }
 
-#ifdef ARDUINO_ARCH_ESP8266
 void ICACHE_RAM_ATTR HOT PulseCounterBase::gpio_intr() {
   const uint32_t now = micros();
   if (now - this->last_pulse_ < this->filter_us_)
     return;
   this->last_pulse_ = now;
 
-  PulseCounterCountMode mode = this->pin_->digital_read() ? this->rising_edge_mode_ : this->falling_edge_mode_;
+  PulseCounterCountMode mode = this->isr_pin_.digital_read() ? this->rising_edge_mode_ : this->falling_edge_mode_;
   switch (mode) {
     case PULSE_COUNTER_DISABLE:
-      break;
+      return;
     case PULSE_COUNTER_INCREMENT:
+#if defined(ARDUINO_ARCH_ESP8266) || defined(ESPHOMELIB_HOST)
       this->counter_++;
+#endif
       break;
     case PULSE_COUNTER_DECREMENT:
+#if defined(ARDUINO_ARCH_ESP8266) || defined(ESPHOMELIB_HOST)
       this->counter_--;
+#endif
       break;
   }
+  this->record_edge_(now);
+}
+void ICACHE_RAM_ATTR HOT PulseCounterBase::record_edge_(uint32_t now) {
+  if (this->edge_times_ == nullptr)
+    return;
+  const uint8_t index = this->edge_index_;
+  this->edge_times_[index] = now;
+  this->edge_index_ = (index + 1) % this->period_samples_;
+  if (this->edge_count_ < this->period_samples_)
+    this->edge_count_++;
+}
+uint8_t PulseCounterBase::read_edges_(uint32_t *times) {
+  disable_interrupts();
+  const uint8_t count = this->edge_count_;
+  // The oldest edge is the one that will be overwritten next.
+  const uint8_t oldest = (this->edge_index_ + this->period_samples_ - count) % this->period_samples_;
+  for (uint8_t i = 0; i < count; i++)
+    times[i] = this->edge_times_[(oldest + i) % this->period_samples_];
+  enable_interrupts();
+  return count;
+}
+float PulseCounterBase::period_rate(const uint32_t *times, uint8_t count, uint32_t now) {
+  if (count < 2)
+    return 0.0f;
+
+  float period = (times[count - 1] - times[0]) / float(count - 1);
+  const uint32_t since_last = now - times[count - 1];
+  // The next edge can't come sooner than that, so the rate is at most 1/since_last.
+  if (since_last > period)
+    period = since_last;
+  if (period == 0.0f)
+    return 0.0f;
+  return 60000000.0f / period;
 }
+int64_t PulseCounterBase::read_total_() {
+  const pulse_counter_t counter = this->read_counter_();
+  // Wrapping difference, so that the 32-bit counter is extended to 64 bits.
+  this->total_ += pulse_counter_t(uint32_t(counter) - uint32_t(this->last_counter_));
+  this->last_counter_ = counter;
+  return this->total_;
+}
+pulse_counter_t PulseCounterBase::read_raw_value_() {
+  const int64_t total = this->read_total_();
+  const pulse_counter_t ret = total - this->last_value_;
+  this->last_value_ = total;
+  return ret;
+}
+
+#ifdef ARDUINO_ARCH_ESP8266
 bool PulseCounterBase::pulse_counter_setup_() {
   this->pin_->setup();
+  this->isr_pin_ = this->pin_->to_fast_gpio();
   auto intr = std::bind(&PulseCounterSensorComponent::gpio_intr, this);
   int intr_mode = CHANGE;
   if (this->rising_edge_mode_ == PULSE_COUNTER_DISABLE) {
@@ -75,15 +132,44 @@ bool PulseCounterBase::pulse_counter_setup_() {
   attachInterrupt(this->pin_->get_pin(), intr, intr_mode);
   return true;
 }
-pulse_counter_t PulseCounterBase::read_raw_value_() {
-  pulse_counter_t counter = this->counter_;
-  pulse_counter_t ret = counter - this->last_value_;
-  this->last_value_ = counter;
-  return ret;
+pulse_counter_t PulseCounterBase::read_counter_() {
+  return this->counter_;
+}
+#endif
+
+#ifdef ESPHOMELIB_HOST
+bool PulseCounterBase::pulse_counter_setup_() {
+  // No interrupt on the host, the simulated edges are fed to gpio_intr() directly.
+  this->pin_->setup();
+  this->isr_pin_ = this->pin_->to_fast_gpio();
+  return true;
+}
+pulse_counter_t PulseCounterBase::read_counter_() {
+  return this->counter_;
 }
 #endif
 
 #ifdef ARDUINO_ARCH_ESP32
+/// The hardware counter is reset to 0 when it reaches +/- this value, and the overflow interrupt fires.
+static const int16_t PCNT_LIMIT = 32000;
+static PulseCounterBase *pcnt_units[PCNT_UNIT_MAX] = {nullptr};
+
+void IRAM_ATTR HOT PulseCounterBase::pcnt_intr(void *arg) {
+  const uint32_t status = PCNT.int_st.val;
+  for (int i = 0; i < PCNT_UNIT_MAX; i++) {
+    if ((status & BIT(i)) == 0)
+      continue;
+    PulseCounterBase *base = pcnt_units[i];
+    const uint32_t unit_status = PCNT.status_unit[i].val;
+    if (base != nullptr) {
+      if (unit_status & PCNT_STATUS_H_LIM_M)
+        base->overflow_ += PCNT_LIMIT;
+      else if (unit_status & PCNT_STATUS_L_LIM_M)
+        base->overflow_ -= PCNT_LIMIT;
+    }
+    PCNT.int_clr.val = BIT(i);
+  }
+}
 bool PulseCounterBase::pulse_counter_setup_() {
   ESP_LOGCONFIG(TAG, "    PCNT Unit Number: %u", this->pcnt_unit_);
 
@@ -106,8 +192,8 @@ bool PulseCounterBase::pulse_counter_setup_() {
       .hctrl_mode = PCNT_MODE_KEEP,
       .pos_mode = rising,
       .neg_mode = falling,
-      .counter_h_lim = 0,
-      .counter_l_lim = 0,
+      .counter_h_lim = PCNT_LIMIT,
+      .counter_l_lim = -PCNT_LIMIT,
       .unit = this->pcnt_unit_,
       .channel = PCNT_CHANNEL_0,
   };
@@ -132,6 +218,20 @@ bool PulseCounterBase::pulse_counter_setup_() {
     }
   }
 
+  // The PCNT interrupt is shared by all units, only register it once.
+  static bool pcnt_isr_registered = false;
+  if (!pcnt_isr_registered) {
+    error = pcnt_isr_register(pcnt_intr, nullptr, 0, nullptr);
+    if (error != ESP_OK) {
+      ESP_LOGE(TAG, "Registering pulse counter interrupt failed: %s", esp_err_to_name(error));
+      return false;
+    }
+    pcnt_isr_registered = true;
+  }
+  pcnt_units[this->pcnt_unit_] = this;
+  pcnt_event_enable(this->pcnt_unit_, PCNT_EVT_H_LIM);
+  pcnt_event_enable(this->pcnt_unit_, PCNT_EVT_L_LIM);
+
   error = pcnt_counter_pause(this->pcnt_unit_);
   if (error != ESP_OK) {
     ESP_LOGE(TAG, "Pausing pulse counter failed: %s", esp_err_to_name(error));
@@ -142,28 +242,70 @@ bool PulseCounterBase::pulse_counter_setup_() {
     ESP_LOGE(TAG, "Clearing pulse counter failed: %s", esp_err_to_name(error));
     return false;
   }
+  pcnt_intr_enable(this->pcnt_unit_);
   error = pcnt_counter_resume(this->pcnt_unit_);
   if (error != ESP_OK) {
     ESP_LOGE(TAG, "Resuming pulse counter failed: %s", esp_err_to_name(error));
     return false;
   }
+
+  if (this->edge_times_ != nullptr) {
+    // The PCNT has no timestamps, capture them with a pin interrupt on the counted edges.
+    // A plain IRAM function, the ISR must keep working while the flash cache is disabled by preference saves.
+    this->isr_pin_ = this->pin_->to_fast_gpio();
+    attachInterruptArg(this->pin_->get_pin(), &PulseCounterBase::gpio_intr_arg_, this, CHANGE);
+  }
   return true;
 }
-pulse_counter_t PulseCounterBase::read_raw_value_() {
-  pulse_counter_t counter;
-  pcnt_get_counter_value(this->pcnt_unit_, &counter);
-  pulse_counter_t ret = counter - this->last_value_;
-  this->last_value_ = counter;
-  return ret;
+void IRAM_ATTR HOT PulseCounterBase::gpio_intr_arg_(void *arg) {
+  reinterpret_cast<PulseCounterBase *>(arg)->gpio_intr();
+}
+pulse_counter_t PulseCounterBase::read_counter_() {
+  const uint32_t unit_bit = BIT(this->pcnt_unit_);
+  pulse_counter_t overflow;
+  int16_t counter;
+  uint32_t pending;
+  // The hardware resets the counter to 0 as soon as it hits a limit, but the overflow interrupt only runs later.
+  // Read with the interrupt held off (it's allocated on this core) and check whether a limit event is pending,
+  // otherwise a read in between would be off by PCNT_LIMIT (about -32000 and then +32000 on the next read).
+  disable_interrupts();
+  do {
+    pending = PCNT.int_st.val & unit_bit;
+    pcnt_get_counter_value(this->pcnt_unit_, &counter);
+    // Retry if the counter hit a limit while it was being read, the value can belong to either side then.
+  } while (pending != (PCNT.int_st.val & unit_bit));
+  overflow = this->overflow_;
+  if (pending) {
+    // Account for the pending limit event here, the interrupt adds it to overflow_ once it runs.
+    const uint32_t unit_status = PCNT.status_unit[this->pcnt_unit_].val;
+    if (unit_status & PCNT_STATUS_H_LIM_M)
+      overflow += PCNT_LIMIT;
+    else if (unit_status & PCNT_STATUS_L_LIM_M)
+      overflow -= PCNT_LIMIT;
+  }
+  enable_interrupts();
+  return overflow + counter;
 }
 #endif
 
 void PulseCounterSensorComponent::setup() {
   ESP_LOGCONFIG(TAG, "Setting up pulse counter '%s'...", this->name_.c_str());
+  if (this->period_samples_ != 0)
+    this->edge_times_ = new uint32_t[this->period_samples_];
   if (!this->pulse_counter_setup_()) {
     this->mark_failed();
     return;
   }
+
+  if (this->total_sensor_ != nullptr) {
+    this->total_pref_ = global_preferences.make_preference<int64_t>(this->total_sensor_->get_object_id_hash());
+    int64_t recovered;
+    if (this->total_pref_.load(&recovered)) {
+      this->total_ = recovered;
+      this->last_value_ = recovered;
+      this->saved_total_ = recovered;
+    }
+  }
 }
 
 void PulseCounterSensorComponent::dump_config() {
@@ -172,23 +314,44 @@ void PulseCounterSensorComponent::dump_config() {
   ESP_LOGCONFIG(TAG, "  Rising Edge: %s", EDGE_MODE_TO_STRING[this->rising_edge_mode_]);
   ESP_LOGCONFIG(TAG, "  Falling Edge: %s", EDGE_MODE_TO_STRING[this->falling_edge_mode_]);
   ESP_LOGCONFIG(TAG, "  Filtering pulses shorter than %u µs", this->filter_us_);
+  if (this->period_samples_ != 0) {
+    ESP_LOGCONFIG(TAG, "  Period measurement over %u edges", this->period_samples_);
+  }
+  LOG_SENSOR("  ", "Total", this->total_sensor_);
 }
 
 void PulseCounterSensorComponent::update() {
   pulse_counter_t raw = this->read_raw_value_();
-  float value = (60000.0f * raw) / float(this->get_update_interval()); // per minute
+  float value;
+  if (this->period_samples_ != 0) {
+    uint32_t times[PULSE_COUNTER_MAX_PERIOD_SAMPLES];
+    const uint8_t count = this->read_edges_(times);
+    value = period_rate(times, count, micros());
+  } else {
+    value = (60000.0f * raw) / float(this->get_update_interval()); // per minute
+  }
 
   ESP_LOGD(TAG, "'%s': Retrieved counter: %0.2f pulses/min", this->get_name().c_str(), value);
   this->publish_state(value);
+
+  if (this->total_sensor_ != nullptr) {
+    this->total_sensor_->publish_state(this->total_);
+    const uint32_t now = millis();
+    if (this->total_ != this->saved_total_ && now - this->last_save_ >= PULSE_COUNTER_SAVE_INTERVAL) {
+      this->total_pref_.save(&this->total_);
+      this->saved_total_ = this->total_;
+      this->last_save_ = now;
+    }
+  }
 }
 
 float PulseCounterSensorComponent::get_setup_priority() const {
   return setup_priority::HARDWARE_LATE;
 }
-std::string PulseCounterSensorComponent::unit_of_measurement() {
+const char *PulseCounterSensorComponent::unit_of_measurement() {
   return "pulses/min";
 }
-std::string PulseCounterSensorComponent::icon() {
+const char *PulseCounterSensorComponent::icon() {
   return "mdi:pulse";
 }
 int8_t PulseCounterSensorComponent::accuracy_decimals() {
@@ -197,10 +360,12 @@ int8_t PulseCounterSensorComponent::accuracy_decimals() {
 void PulseCounterSensorComponent::set_filter_us(uint32_t filter_us) {
   this->filter_us_ = filter_us;
 }
-
-#ifdef ARDUINO_ARCH_ESP32
-pcnt_unit_t next_pcnt_unit = PCNT_UNIT_0;
-#endif
+void PulseCounterSensorComponent::set_period_samples(uint8_t samples) {
+  this->period_samples_ = std::min(samples, PULSE_COUNTER_MAX_PERIOD_SAMPLES);
+}
+PulseCounterTotalSensor *PulseCounterSensorComponent::make_total_sensor(const std::string &name) {
+  return this->total_sensor_ = new PulseCounterTotalSensor(name, this);
+}
 
 } // namespace sensor
 
@@ -7,6 +7,7 @@
 
 #include "esphomelib/sensor/sensor.h"
 #include "esphomelib/esphal.h"
+#include "esphomelib/esppreferences.h"
 
 #ifdef ARDUINO_ARCH_ESP32
   #include <driver/pcnt.h>
@@ -22,38 +23,76 @@ enum PulseCounterCountMode {
   PULSE_COUNTER_DECREMENT,
 };
 
-#ifdef ARDUINO_ARCH_ESP32
-using pulse_counter_t = int16_t;
-#endif
-#ifdef ARDUINO_ARCH_ESP8266
 using pulse_counter_t = int32_t;
-#endif
+
+/// The maximum number of edges that can be used for period measurements.
+static const uint8_t PULSE_COUNTER_MAX_PERIOD_SAMPLES = 32;
 
 class PulseCounterBase {
  public:
   PulseCounterBase(GPIOPin *pin);
   bool pulse_counter_setup_();
+  /// Get the number of pulses since the last call.
   pulse_counter_t read_raw_value_();
+  /// Get the total number of pulses, extended to 64 bits so that it never overflows.
+  int64_t read_total_();
 
   GPIOPin *get_pin();
 
+  /** Estimate the pulse rate from the timestamps of the last edges.
+   *
+   * The rate is computed from the average period between the edges. If no edge has been seen for longer
+   * than that period, the time since the last edge is used instead, so that the rate decays towards 0
+   * when the pulses stop.
+   *
+   * @param times Timestamps of the edges in µs, oldest first.
+   * @param count The number of timestamps.
+   * @param now The current time in µs.
+   * @return The rate in pulses/min, 0 if there are not enough edges.
+   */
+  static float period_rate(const uint32_t *times, uint8_t count, uint32_t now);
+
  protected:
-#ifdef ARDUINO_ARCH_ESP8266
+  /// Read the raw 32-bit (wrapping) counter value.
+  pulse_counter_t read_counter_();
+  /// Store the timestamp of a counted edge for period measurements.
+  void record_edge_(uint32_t now);
+  /// Copy the recorded edge timestamps into times (oldest first), returns the number of timestamps.
+  uint8_t read_edges_(uint32_t *times);
+
   void gpio_intr();
-  volatile pulse_counter_t counter_{0};
+  FastGPIO isr_pin_;
   volatile uint32_t last_pulse_{0};
+#if defined(ARDUINO_ARCH_ESP8266) || defined(ESPHOMELIB_HOST)
+  volatile pulse_counter_t counter_{0};
 #endif
 
   GPIOPin *pin_;
 #ifdef ARDUINO_ARCH_ESP32
+  static void pcnt_intr(void *arg);
+  /// GPIO interrupt for period measurements, arg is the PulseCounterBase.
+  static void gpio_intr_arg_(void *arg);
+
   pcnt_unit_t pcnt_unit_;
+  /// Pulses accumulated by the overflow interrupt, each time the hardware counter hits a limit.
+  volatile pulse_counter_t overflow_{0};
 #endif
   PulseCounterCountMode rising_edge_mode_{PULSE_COUNTER_INCREMENT};
   PulseCounterCountMode falling_edge_mode_{PULSE_COUNTER_DISABLE};
   uint32_t filter_us_{13};
-  pulse_counter_t last_value_{0};
+  pulse_counter_t last_counter_{0};
+  int64_t total_{0};
+  int64_t last_value_{0};
+  uint8_t period_samples_{0};
+  volatile uint32_t *edge_times_{nullptr};
+  volatile uint8_t edge_index_{0};
+  volatile uint8_t edge_count_{0};
 };
 
+class PulseCounterSensorComponent;
+
+using PulseCounterTotalSensor = EmptyPollingParentSensor<0, ICON_PULSE, UNIT_PULSES, PulseCounterSensorComponent>;
+
 /** Pulse Counter - This is the sensor component for the ESP32 integrated pulse counter peripheral.
  *
  * It offers 8 pulse counter units that can be setup in several ways to count pulses on a pin.
@@ -82,21 +121,41 @@ class PulseCounterSensorComponent : public PollingSensorComponent, public PulseC
 
   void set_filter_us(uint32_t filter_us);
 
+  /** Measure the rate from the period between the last edges instead of counting pulses per update interval.
+   *
+   * This is much more accurate for low pulse rates, where only a few pulses happen during an update interval.
+   *
+   * @param samples The number of edges to average the period over, 0 to disable. At most 32.
+   */
+  void set_period_samples(uint8_t samples);
+
+  /** Create a sensor that reports the total number of pulses.
+   *
+   * The total is stored in the preferences, so that it survives reboots. To keep flash wear low,
+   * it's only saved once per minute when it has changed.
+   *
+   * The total is counted in 64 bits, but published as a float like all sensor states, which is only exact
+   * up to 2^24 (16777216) pulses. Above that the published value is rounded to the nearest float, the stored
+   * total stays exact.
+   */
+  PulseCounterTotalSensor *make_total_sensor(const std::string &name);
   // ========== INTERNAL METHODS ==========
   // (In most use cases you won't need these)
   /// Unit of measurement is "pulses/min".
-  std::string unit_of_measurement() override;
-  std::string icon() override;
+  const char *unit_of_measurement() override;
+  const char *icon() override;
   int8_t accuracy_decimals() override;
   void setup() override;
   void update() override;
   float get_setup_priority() const override;
   void dump_config() override;
-};
 
-#ifdef ARDUINO_ARCH_ESP32
-extern pcnt_unit_t next_pcnt_unit;
-#endif
+ protected:
+  PulseCounterTotalSensor *total_sensor_{nullptr};
+  ESPPreferenceObject total_pref_;
+  int64_t saved_total_{0};
+  uint32_t last_save_{0};
+};
 
 } // namespace sensor
 
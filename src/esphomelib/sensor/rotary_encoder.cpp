@@ -4,6 +4,11 @@
 
 #include "esphomelib/sensor/rotary_encoder.h"
 #include "esphomelib/log.h"
+#include "esphomelib/helpers.h"
+
+#ifdef ARDUINO_ARCH_ESP8266
+  #include "FunctionalInterrupt.h"
+#endif
 
 ESPHOMELIB_NAMESPACE_BEGIN
 
@@ -83,36 +88,62 @@ RotaryEncoderSensor::RotaryEncoderSensor(const std::string &name, GPIOPin *pin_a
 }
 void RotaryEncoderSensor::setup() {
   ESP_LOGCONFIG(TAG, "Setting up Rotary Encoder '%s'...", this->name_.c_str());
-  int interrupt_a = digitalPinToInterrupt(this->pin_a_->get_pin());
   this->pin_a_->setup();
-  attachInterrupt(interrupt_a, RotaryEncoderSensor::encoder_isr_, CHANGE);
-
-  int interrupt_b = digitalPinToInterrupt(this->pin_b_->get_pin());
+  this->pin_a_fast_ = this->pin_a_->to_fast_gpio();
   this->pin_b_->setup();
-  attachInterrupt(interrupt_b, RotaryEncoderSensor::encoder_isr_, CHANGE);
+  this->pin_b_fast_ = this->pin_b_->to_fast_gpio();
 
   if (this->pin_i_ != nullptr) {
     this->pin_i_->setup();
+    this->pin_i_fast_ = this->pin_i_->to_fast_gpio();
+  }
+
+#ifdef ARDUINO_ARCH_ESP32
+  if (this->use_pcnt_) {
+    if (!this->setup_pcnt_()) {
+      this->mark_failed();
+    }
+    return;
   }
-  global_rotary_encoders_.push_back(this);
+#endif
+
+  // Each encoder gets its own interrupt, so an edge only processes the encoder it belongs to.
+#ifdef ARDUINO_ARCH_ESP8266
+  auto intr = std::bind(&RotaryEncoderSensor::process_state_machine_, this);
+  attachInterrupt(digitalPinToInterrupt(this->pin_a_->get_pin()), intr, CHANGE);
+  attachInterrupt(digitalPinToInterrupt(this->pin_b_->get_pin()), intr, CHANGE);
+#endif
+#ifdef ARDUINO_ARCH_ESP32
+  attachInterruptArg(digitalPinToInterrupt(this->pin_a_->get_pin()), &RotaryEncoderSensor::encoder_isr_, this, CHANGE);
+  attachInterruptArg(digitalPinToInterrupt(this->pin_b_->get_pin()), &RotaryEncoderSensor::encoder_isr_, this, CHANGE);
+#endif
+}
+#ifdef ARDUINO_ARCH_ESP32
+void ICACHE_RAM_ATTR HOT RotaryEncoderSensor::encoder_isr_(void *arg) {
+  reinterpret_cast<RotaryEncoderSensor *>(arg)->process_state_machine_();
 }
+#endif
 
 void RotaryEncoderSensor::dump_config() {
   LOG_SENSOR("", "Rotary Encoder", this);
   LOG_PIN("  Pin A: ", this->pin_a_);
   LOG_PIN("  Pin B: ", this->pin_b_);
   LOG_PIN("  Pin I: ", this->pin_i_);
-}
-void ICACHE_RAM_ATTR RotaryEncoderSensor::encoder_isr_() {
-  for (auto *encoder : global_rotary_encoders_) {
-    encoder->process_state_machine_();
+  if (this->acceleration_threshold_ > 0.0f) {
+    ESP_LOGCONFIG(TAG, "  Acceleration: above %.1f steps/s, up to %.1fx", this->acceleration_threshold_,
+                  this->acceleration_max_);
+  }
+#ifdef ARDUINO_ARCH_ESP32
+  if (this->use_pcnt_) {
+    ESP_LOGCONFIG(TAG, "  PCNT Unit Number: %u", this->pcnt_unit_);
   }
+#endif
 }
-void ICACHE_RAM_ATTR RotaryEncoderSensor::process_state_machine_() {
+void ICACHE_RAM_ATTR HOT RotaryEncoderSensor::process_state_machine_() {
   this->state_ &= QEIx4_MASK;
-  if (this->pin_a_->digital_read())
+  if (this->pin_a_fast_.digital_read())
     this->state_ |= QEIx4_A;
-  if (this->pin_b_->digital_read())
+  if (this->pin_b_fast_.digital_read())
     this->state_ |= QEIx4_B;
 
   this->state_ = state_lookup_table[this->state_];
@@ -130,23 +161,155 @@ void ICACHE_RAM_ATTR RotaryEncoderSensor::process_state_machine_() {
       counter_change = true;
     }
 
-    if (counter_change && this->pin_i_ != nullptr && this->pin_i_->digital_read()) {
+    if (counter_change && this->pin_i_ != nullptr && this->pin_i_fast_.digital_read()) {
       this->counter_ = 0;
+      this->index_reset_ = true;
     }
 
+    if (counter_change)
+      this->record_step_(micros(), 1);
+
     this->has_changed_ = this->has_changed_ || counter_change;
   }
 }
+void ICACHE_RAM_ATTR HOT RotaryEncoderSensor::record_step_(uint32_t now, uint32_t steps) {
+  this->step_interval_ = (now - this->last_step_) / steps;
+  this->last_step_ = now;
+}
+int32_t RotaryEncoderSensor::accelerate_(int32_t delta) {
+  const uint32_t step_interval = this->step_interval_;
+  if (this->acceleration_threshold_ <= 0.0f || step_interval == 0)
+    return delta;
+
+  const float speed = 1000000.0f / step_interval; // steps/s
+  const float multiplier = clamp(1.0f, this->acceleration_max_, speed / this->acceleration_threshold_);
+  return lroundf(delta * multiplier);
+}
 void RotaryEncoderSensor::loop() {
-  if (this->has_changed_) {
-    this->has_changed_ = false;
-    this->publish_state(this->counter_);
+#ifdef ARDUINO_ARCH_ESP32
+  if (this->use_pcnt_)
+    this->read_pcnt_();
+#endif
+
+  if (!this->has_changed_)
+    return;
+  this->has_changed_ = false;
+
+  const bool index_reset = this->index_reset_;
+  this->index_reset_ = false;
+  const int32_t counter = this->counter_;
+  const int32_t delta = counter - this->last_counter_;
+  this->last_counter_ = counter;
+
+  if (index_reset) {
+    this->value_ = counter;
+  } else {
+    this->value_ += this->accelerate_(delta);
   }
+  this->publish_state(this->value_);
 }
-std::string RotaryEncoderSensor::unit_of_measurement() {
+
+#ifdef ARDUINO_ARCH_ESP32
+/// The PCNT counter is reset to 0 when it reaches +/- this value, so it counts modulo PCNT_LIMIT.
+static const int16_t PCNT_LIMIT = INT16_MAX;
+
+bool RotaryEncoderSensor::setup_pcnt_() {
+  this->pcnt_unit_ = select_next_pcnt_unit();
+
+  // Standard quadrature decoding: each channel counts the edges of one pin, with the other pin's level
+  // giving the direction. Together they count 4 edges per A-B cycle.
+  pcnt_config_t config_a = {
+      .pulse_gpio_num = this->pin_a_->get_pin(),
+      .ctrl_gpio_num = this->pin_b_->get_pin(),
+      .lctrl_mode = PCNT_MODE_REVERSE,
+      .hctrl_mode = PCNT_MODE_KEEP,
+      .pos_mode = PCNT_COUNT_DEC,
+      .neg_mode = PCNT_COUNT_INC,
+      .counter_h_lim = PCNT_LIMIT,
+      .counter_l_lim = -PCNT_LIMIT,
+      .unit = this->pcnt_unit_,
+      .channel = PCNT_CHANNEL_0,
+  };
+  pcnt_config_t config_b = {
+      .pulse_gpio_num = this->pin_b_->get_pin(),
+      .ctrl_gpio_num = this->pin_a_->get_pin(),
+      .lctrl_mode = PCNT_MODE_REVERSE,
+      .hctrl_mode = PCNT_MODE_KEEP,
+      .pos_mode = PCNT_COUNT_INC,
+      .neg_mode = PCNT_COUNT_DEC,
+      .counter_h_lim = PCNT_LIMIT,
+      .counter_l_lim = -PCNT_LIMIT,
+      .unit = this->pcnt_unit_,
+      .channel = PCNT_CHANNEL_1,
+  };
+  esp_err_t error = pcnt_unit_config(&config_a);
+  if (error == ESP_OK)
+    error = pcnt_unit_config(&config_b);
+  if (error != ESP_OK) {
+    ESP_LOGE(TAG, "Configuring PCNT failed: %s", esp_err_to_name(error));
+    return false;
+  }
+
+  // Maximum glitch filter (about 12.8µs), mechanical encoders bounce a lot.
+  pcnt_set_filter_value(this->pcnt_unit_, 1023);
+  pcnt_filter_enable(this->pcnt_unit_);
+
+  pcnt_counter_pause(this->pcnt_unit_);
+  pcnt_counter_clear(this->pcnt_unit_);
+  error = pcnt_counter_resume(this->pcnt_unit_);
+  if (error != ESP_OK) {
+    ESP_LOGE(TAG, "Starting PCNT failed: %s", esp_err_to_name(error));
+    return false;
+  }
+  return true;
+}
+void RotaryEncoderSensor::read_pcnt_() {
+  int16_t value;
+  pcnt_get_counter_value(this->pcnt_unit_, &value);
+  // Both limits reset the counter to 0, so it always equals the true count modulo PCNT_LIMIT. Take the
+  // shortest distance, the encoder can't move by half the range within a single loop iteration.
+  int32_t delta = (int32_t(value) - this->last_pcnt_value_) % PCNT_LIMIT;
+  if (delta > PCNT_LIMIT / 2)
+    delta -= PCNT_LIMIT;
+  else if (delta < -PCNT_LIMIT / 2)
+    delta += PCNT_LIMIT;
+  if (delta == 0)
+    return;
+  this->last_pcnt_value_ = value;
+  this->pcnt_total_ += delta;
+
+  int32_t divisor = 1;
+  switch (this->resolution_) {
+    case ROTARY_ENCODER_1_PULSE_PER_CYCLE: divisor = 4; break;
+    case ROTARY_ENCODER_2_PULSES_PER_CYCLE: divisor = 2; break;
+    case ROTARY_ENCODER_4_PULSES_PER_CYCLE: divisor = 1; break;
+  }
+  // Round towards negative infinity, so that there's no double-sized dead zone around 0.
+  const int32_t total = this->pcnt_total_;
+  const int32_t counter = total >= 0 ? total / divisor : (total - divisor + 1) / divisor;
+  const int32_t steps = counter - this->counter_;
+  if (steps == 0)
+    return;
+
+  if (this->pin_i_ != nullptr && this->pin_i_fast_.digital_read()) {
+    this->pcnt_total_ = 0;
+    this->counter_ = 0;
+    this->index_reset_ = true;
+  } else {
+    this->counter_ = counter;
+  }
+  this->record_step_(micros(), steps < 0 ? -steps : steps);
+  this->has_changed_ = true;
+}
+void RotaryEncoderSensor::set_use_pcnt(bool use_pcnt) {
+  this->use_pcnt_ = use_pcnt;
+}
+#endif
+
+const char *RotaryEncoderSensor::unit_of_measurement() {
   return "steps";
 }
-std::string RotaryEncoderSensor::icon() {
+const char *RotaryEncoderSensor::icon() {
   return "mdi:rotate-right";
 }
 int8_t RotaryEncoderSensor::accuracy_decimals() {
@@ -158,8 +321,10 @@ void RotaryEncoderSensor::set_resolution(RotaryEncoderResolution mode) {
 void RotaryEncoderSensor::set_reset_pin(const GPIOInputPin &pin_i) {
   this->pin_i_ = pin_i.copy();
 }
-
-std::vector<RotaryEncoderSensor *> global_rotary_encoders_;
+void RotaryEncoderSensor::set_acceleration(float threshold, float max_multiplier) {
+  this->acceleration_threshold_ = threshold;
+  this->acceleration_max_ = max_multiplier;
+}
 
 float RotaryEncoderSensor::get_setup_priority() const {
   return setup_priority::HARDWARE_LATE;
@@ -10,6 +10,10 @@
 #include "esphomelib/sensor/sensor.h"
 #include "esphomelib/esphal.h"
 
+#ifdef ARDUINO_ARCH_ESP32
+  #include <driver/pcnt.h>
+#endif
+
 ESPHOMELIB_NAMESPACE_BEGIN
 
 namespace sensor {
@@ -36,37 +40,75 @@ class RotaryEncoderSensor : public Sensor, public Component {
 
   void set_reset_pin(const GPIOInputPin &pin_i);
 
+  /** Enable acceleration: when the encoder is turned faster than threshold steps per second, each step counts
+   * as (speed / threshold) steps, up to max_multiplier.
+   *
+   * @param threshold The speed in steps/s above which steps are scaled.
+   * @param max_multiplier The maximum number of steps a single step can count as.
+   */
+  void set_acceleration(float threshold, float max_multiplier);
+
+#ifdef ARDUINO_ARCH_ESP32
+  /** Count with the PCNT peripheral in quadrature mode instead of with pin interrupts.
+   *
+   * This needs no CPU time per step and filters glitches in hardware, but uses one of the 8 PCNT units.
+   * Defaults to false.
+   */
+  void set_use_pcnt(bool use_pcnt);
+#endif
+
   // ========== INTERNAL METHODS ==========
   // (In most use cases you won't need these)
   void setup() override;
   void dump_config() override;
   void loop() override;
-  std::string unit_of_measurement() override;
-  std::string icon() override;
+  const char *unit_of_measurement() override;
+  const char *icon() override;
   int8_t accuracy_decimals() override;
 
   float get_setup_priority() const override;
 
  protected:
-  /// The ISR that handles pushing all interrupts to process_state_machine_ of all rotary encoders.
-  static void encoder_isr_();
-
-  /// Process the state machine state of this rotary encoder. Called from encoder_isr_
+  /// Process the state machine state of this rotary encoder. Called from the pin interrupts of this encoder.
   void process_state_machine_();
+  /// Store the step timing for acceleration, called for every step.
+  void record_step_(uint32_t now, uint32_t steps);
+  /// Scale the steps according to the current speed.
+  int32_t accelerate_(int32_t delta);
+
+#ifdef ARDUINO_ARCH_ESP32
+  /// Pin interrupt of the encoder passed as arg.
+  static void encoder_isr_(void *arg);
+  bool setup_pcnt_();
+  /// Fold the hardware counter into counter_.
+  void read_pcnt_();
+
+  bool use_pcnt_{false};
+  pcnt_unit_t pcnt_unit_;
+  int16_t last_pcnt_value_{0};
+  int32_t pcnt_total_{0}; /// Quadrature edges (4 per A-B cycle) counted by the PCNT.
+#endif
 
   GPIOPin *pin_a_;
   GPIOPin *pin_b_;
   GPIOPin *pin_i_{nullptr}; /// Index pin, if this is not nullptr, the counter will reset to 0 once this pin is HIGH.
+  FastGPIO pin_a_fast_;
+  FastGPIO pin_b_fast_;
+  FastGPIO pin_i_fast_;
 
   volatile int32_t counter_{0}; /// The internal counter for steps
   volatile bool has_changed_{true};
+  volatile bool index_reset_{false}; /// Whether counter_ has been reset by the index pin.
+  volatile uint32_t last_step_{0}; /// Time of the last step in µs.
+  volatile uint32_t step_interval_{0}; /// Time between the last two steps in µs.
   uint16_t state_{0};
   RotaryEncoderResolution resolution_{ROTARY_ENCODER_1_PULSE_PER_CYCLE};
+  int32_t last_counter_{0};
+  int32_t value_{0}; /// The published (accelerated) value.
+  float acceleration_threshold_{0.0f}; /// 0 disables acceleration.
+  float acceleration_max_{1.0f};
 };
 
-/// Global storage for having multiple rotary encoders with a single ISR
-extern std::vector<RotaryEncoderSensor *> global_rotary_encoders_;
-
 } // namespace sensor
 
 ESPHOMELIB_NAMESPACE_END
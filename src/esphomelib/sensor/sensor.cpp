@@ -28,10 +28,10 @@ void Sensor::publish_state(float state) {
 void Sensor::push_new_value(float state) {
   this->publish_state(state);
 }
-std::string Sensor::unit_of_measurement() {
+const char *Sensor::unit_of_measurement() {
   return "";
 }
-std::string Sensor::icon() {
+const char *Sensor::icon() {
   return "";
 }
 uint32_t Sensor::update_interval() {
@@ -64,14 +64,14 @@ void Sensor::add_on_state_callback(std::function<void(float)> &&callback) {
 void Sensor::add_on_raw_state_callback(std::function<void(float)> &&callback) {
   this->raw_callback_.add(std::move(callback));
 }
-std::string Sensor::get_icon() {
+const char *Sensor::get_icon() {
   if (this->icon_.has_value())
-    return *this->icon_;
+    return this->icon_->c_str();
   return this->icon();
 }
-std::string Sensor::get_unit_of_measurement() {
+const char *Sensor::get_unit_of_measurement() {
   if (this->unit_of_measurement_.has_value())
-    return *this->unit_of_measurement_;
+    return this->unit_of_measurement_->c_str();
   return this->unit_of_measurement();
 }
 int8_t Sensor::get_accuracy_decimals() {
@@ -127,7 +127,7 @@ void Sensor::send_state_to_frontend_internal_(float state) {
   this->state = state;
   if (this->filter_list_ != nullptr) {
     ESP_LOGD(TAG, "'%s': Sending state %.5f %s with %d decimals of accuracy",
-             this->get_name().c_str(), state, this->get_unit_of_measurement().c_str(),
+             this->get_name().c_str(), state, this->get_unit_of_measurement(),
              this->get_accuracy_decimals());
   }
   this->callback_.call(state);
@@ -198,6 +198,11 @@ const char UNIT_K[] = "K";
 const char UNIT_MICROSIEMENS_PER_CENTIMETER[] = "µS/cm";
 const char UNIT_MICROGRAMS_PER_CUBIC_METER[] = "µg/m^3";
 const char ICON_CHEMICAL_WEAPON[] = "mdi:chemical-weapon";
+const char ICON_PULSE[] = "mdi:pulse";
+const char UNIT_PULSES[] = "pulses";
+const char ICON_MEMORY[] = "mdi:memory";
+const char UNIT_BYTES[] = "B";
+const char UNIT_ALLOCATIONS_PER_MINUTE[] = "allocs/min";
 
 SensorStateTrigger::SensorStateTrigger(Sensor *parent) {
   parent->add_on_state_callback([this](float value) {
@@ -244,12 +249,15 @@ void ValueRangeTrigger::on_state_(float state) {
     in_range = local_min <= state && state <= local_max;
   }
 
-  if (in_range != this->previous_in_range_ && in_range) {
-    this->trigger(state);
-  }
+  if (in_range == this->previous_in_range_)
+    return;
 
+  // Only transitions are stored, so flash isn't written for every state.
   this->previous_in_range_ = in_range;
   this->rtc_.save(&in_range);
+  if (in_range) {
+    this->trigger(state);
+  }
 }
 void ValueRangeTrigger::setup() {
   this->rtc_ = global_preferences.make_preference<bool>(this->parent_->get_object_id_hash());
@@ -27,10 +27,10 @@ class SensorInRangeCondition;
 #define LOG_SENSOR(prefix, type, obj) \
     if (obj != nullptr) { \
       ESP_LOGCONFIG(TAG, prefix type " '%s'", obj->get_name().c_str()); \
-      ESP_LOGCONFIG(TAG, prefix "  Unit of Measurement: '%s'", obj->get_unit_of_measurement().c_str()); \
+      ESP_LOGCONFIG(TAG, prefix "  Unit of Measurement: '%s'", obj->get_unit_of_measurement()); \
       ESP_LOGCONFIG(TAG, prefix "  Accuracy Decimals: %d", obj->get_accuracy_decimals()); \
-      if (!obj->get_icon().empty()) { \
-        ESP_LOGCONFIG(TAG, prefix "  Icon: '%s'", obj->get_icon().c_str()); \
+      if (obj->get_icon()[0] != '\0') { \
+        ESP_LOGCONFIG(TAG, prefix "  Icon: '%s'", obj->get_icon()); \
       } \
       if (!obj->unique_id().empty()) { \
         ESP_LOGV(TAG, prefix "  Unique ID: '%s'", obj->unique_id().c_str()); \
@@ -101,10 +101,10 @@ class Sensor : public Nameable {
   int8_t get_accuracy_decimals();
 
   /// Get the unit of measurement. Uses the manual override if specified or the default value instead.
-  std::string get_unit_of_measurement();
+  const char *get_unit_of_measurement();
 
   /// Get the Home Assistant Icon. Uses the manual override if specified or the default value instead.
-  std::string get_icon();
+  const char *get_icon();
 
   /** Publish a new state to the front-end.
    *
@@ -179,19 +179,21 @@ class Sensor : public Nameable {
  protected:
   /** Override this to set the Home Assistant unit of measurement for this sensor.
    *
-   * Return "" to disable this feature.
+   * Return "" to disable this feature. The returned string is not copied, so it must have static
+   * storage duration (for example a string literal or one of the UNIT_ constants).
    *
-   * @return The icon of this sensor, for example "°C".
+   * @return The unit of measurement of this sensor, for example "°C".
    */
-  virtual std::string unit_of_measurement();
+  virtual const char *unit_of_measurement();
 
   /** Override this to set the Home Assistant icon for this sensor.
    *
-   * Return "" to disable this feature.
+   * Return "" to disable this feature. The returned string is not copied, so it must have static
+   * storage duration (for example a string literal or one of the ICON_ constants).
    *
    * @return The icon of this sensor, for example "mdi:battery".
    */
-  virtual std::string icon();
+  virtual const char *icon();
 
   /// Return the accuracy in decimals for this sensor.
   virtual int8_t accuracy_decimals();
@@ -225,10 +227,10 @@ class EmptySensor : public Sensor {
 
   }
 
-  std::string unit_of_measurement() override {
+  const char *unit_of_measurement() override {
     return default_unit_of_measurement;
   }
-  std::string icon() override {
+  const char *icon() override {
     return default_icon;
   }
   int8_t accuracy_decimals() override {
@@ -290,15 +292,17 @@ class ValueRangeTrigger : public Trigger<float>, public Component {
   TemplatableValue<float, float> max_{NAN};
 };
 
+/// Whether the state of a sensor is in a range, recomputed only when the sensor publishes a new state.
 template<typename T>
-class SensorInRangeCondition : public Condition<T> {
+class SensorInRangeCondition : public StateCondition<T> {
  public:
   SensorInRangeCondition(Sensor *parent);
 
   void set_min(float min);
   void set_max(float max);
-  bool check(T x) override;
  protected:
+  void update_result_();
+
   Sensor *parent_;
   float min_{NAN};
   float max_{NAN};
@@ -319,6 +323,8 @@ extern const char ICON_LIGHTBULB[];
 extern const char ICON_BATTERY[];
 extern const char ICON_FLOWER[];
 extern const char ICON_CHEMICAL_WEAPON[];
+extern const char ICON_PULSE[];
+extern const char ICON_MEMORY[];
 
 extern const char UNIT_C[];
 extern const char UNIT_PERCENT[];
@@ -336,31 +342,42 @@ extern const char UNIT_DEGREES[];
 extern const char UNIT_K[];
 extern const char UNIT_MICROSIEMENS_PER_CENTIMETER[];
 extern const char UNIT_MICROGRAMS_PER_CUBIC_METER[];
+extern const char UNIT_PULSES[];
+extern const char UNIT_BYTES[];
+extern const char UNIT_ALLOCATIONS_PER_MINUTE[];
 
 template<typename T>
 SensorInRangeCondition<T> *Sensor::make_sensor_in_range_condition() {
   return new SensorInRangeCondition<T>(this);
 }
 template<typename T>
-SensorInRangeCondition<T>::SensorInRangeCondition(Sensor *parent) : parent_(parent) {}
+SensorInRangeCondition<T>::SensorInRangeCondition(Sensor *parent) : parent_(parent) {
+  parent->add_on_state_callback([this](float state) {
+    this->update_result_();
+  });
+}
 template<typename T>
 void SensorInRangeCondition<T>::set_min(float min) {
   this->min_ = min;
+  this->update_result_();
 }
 template<typename T>
 void SensorInRangeCondition<T>::set_max(float max) {
   this->max_ = max;
+  this->update_result_();
 }
 template<typename T>
-bool SensorInRangeCondition<T>::check(T x) {
+void SensorInRangeCondition<T>::update_result_() {
   const float state = this->parent_->state;
+  bool result;
   if (isnan(this->min_)) {
-    return state <= this->max_;
+    result = state <= this->max_;
   } else if (isnan(this->max_)) {
-    return state >= this->min_;
+    result = state >= this->min_;
   } else {
-    return this->min_ <= state && state <= this->max_;
+    result = this->min_ <= state && state <= this->max_;
   }
+  this->publish_result_(result);
 }
 
 } // namespace sensor
@@ -43,11 +43,14 @@ void TCS34725Component::setup() {
     this->mark_failed();
     return;
   }
-  delay(3);
-  if (!this->write_byte(TCS34725_REGISTER_ENABLE, 0x03)) { // Power on (internal oscillator on) + RGBC ADC Enable
-    this->mark_failed();
-    return;
-  }
+  // The oscillator needs 2.4ms to warm up before the ADC can be enabled.
+  this->set_timeout("enable", 3, [this]() {
+    if (!this->write_byte(TCS34725_REGISTER_ENABLE, 0x03)) { // Power on (internal oscillator on) + RGBC ADC Enable
+      this->mark_failed();
+      return;
+    }
+    this->enabled_ = true;
+  });
 }
 
 void TCS34725Component::dump_config() {
@@ -69,6 +72,11 @@ float TCS34725Component::get_setup_priority() const {
   return setup_priority::HARDWARE_LATE;
 }
 void TCS34725Component::update() {
+  if (!this->enabled_) {
+    this->set_timeout("update", 3, [this]() { this->update(); });
+    return;
+  }
+
   uint16_t raw_c;
   uint16_t raw_r;
   uint16_t raw_g;
@@ -60,6 +60,7 @@ class TCS34725Component : public PollingComponent, public I2CDevice {
   TCS35725ColorTemperatureSensor *color_temperature_sensor_{nullptr};
   TCS34725IntegrationTime integration_time_{TCS34725_INTEGRATION_TIME_2_4MS};
   TCS34725Gain gain_{TCS34725_GAIN_1X};
+  bool enabled_{false}; ///< Whether the RGBC ADC has been enabled (second setup stage).
 };
 
 } // namespace sensor
@@ -34,10 +34,12 @@ float TotalDailyEnergy::get_setup_priority() const {
 uint32_t TotalDailyEnergy::update_interval() {
   return this->parent_->update_interval();
 }
-std::string TotalDailyEnergy::unit_of_measurement() {
-  return this->parent_->get_unit_of_measurement() + "h";
+const char *TotalDailyEnergy::unit_of_measurement() {
+  if (this->unit_of_measurement_cache_.empty())
+    this->unit_of_measurement_cache_ = std::string(this->parent_->get_unit_of_measurement()) + "h";
+  return this->unit_of_measurement_cache_.c_str();
 }
-std::string TotalDailyEnergy::icon() {
+const char *TotalDailyEnergy::icon() {
   return this->parent_->get_icon();
 }
 int8_t TotalDailyEnergy::accuracy_decimals() {
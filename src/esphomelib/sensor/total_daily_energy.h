@@ -21,8 +21,8 @@ class TotalDailyEnergy : public Sensor, public Component {
   void dump_config() override;
   float get_setup_priority() const override;
   uint32_t update_interval() override;
-  std::string unit_of_measurement() override;
-  std::string icon() override;
+  const char *unit_of_measurement() override;
+  const char *icon() override;
   int8_t accuracy_decimals() override;
   void loop() override;
 
@@ -37,6 +37,7 @@ class TotalDailyEnergy : public Sensor, public Component {
   uint16_t last_day_of_year_{};
   uint32_t last_update_{0};
   float total_energy_{0.0f};
+  std::string unit_of_measurement_cache_; ///< The parent's unit with "h" appended, built on first use.
 };
 
 } // namespace sensor
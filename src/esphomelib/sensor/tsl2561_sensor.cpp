@@ -142,10 +142,10 @@ void TSL2561Sensor::read_data_() {
   this->publish_state(lx);
   this->status_clear_warning();
 }
-std::string TSL2561Sensor::unit_of_measurement() {
+const char *TSL2561Sensor::unit_of_measurement() {
   return UNIT_LX;
 }
-std::string TSL2561Sensor::icon() {
+const char *TSL2561Sensor::icon() {
   return ICON_BRIGHTNESS_5;
 }
 int8_t TSL2561Sensor::accuracy_decimals() {
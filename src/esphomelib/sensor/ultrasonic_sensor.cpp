@@ -12,6 +12,13 @@ ESPHOMELIB_NAMESPACE_BEGIN
 namespace sensor {
 
 static const char *TAG = "sensor.ultrasonic";
+/// Minimum time between two trigger pulses (of any sensor), recommended by the HC-SR04 datasheet.
+static const uint32_t ULTRASONIC_MEASUREMENT_CYCLE = 60;
+
+/// The sensor that's currently measuring, only one sensor is triggered at a time to avoid crosstalk.
+/// The shared echo ISR dispatches directly to it.
+static UltrasonicSensorComponent *volatile active_ultrasonic_sensor = nullptr;
+static uint32_t last_ultrasonic_trigger = 0;
 
 UltrasonicSensorComponent::UltrasonicSensorComponent(const std::string &name,
                                                      GPIOPin *trigger_pin, GPIOPin *echo_pin,
@@ -23,8 +30,11 @@ UltrasonicSensorComponent::UltrasonicSensorComponent(const std::string &name,
 void UltrasonicSensorComponent::setup() {
   ESP_LOGCONFIG(TAG, "Setting up Ultrasonic Sensor...");
   this->echo_pin_->setup();
+  this->echo_isr_pin_ = this->echo_pin_->to_fast_gpio();
   this->trigger_pin_->setup();
   this->trigger_pin_->digital_write(false);
+
+  attachInterrupt(this->echo_pin_->get_pin(), gpio_intr_, CHANGE);
 }
 void UltrasonicSensorComponent::dump_config() {
   LOG_SENSOR("", "Ultrasonic Sensor", this);
@@ -35,25 +45,72 @@ void UltrasonicSensorComponent::dump_config() {
   LOG_UPDATE_INTERVAL(this);
 }
 void UltrasonicSensorComponent::update() {
+  this->measurement_requested_ = true;
+}
+void UltrasonicSensorComponent::loop() {
+  switch (this->state_) {
+    case MeasurementState::IDLE:
+      if (!this->measurement_requested_ || active_ultrasonic_sensor != nullptr)
+        return;
+      if (millis() - last_ultrasonic_trigger < ULTRASONIC_MEASUREMENT_CYCLE)
+        return;
+      this->start_measurement_();
+      return;
+    case MeasurementState::ECHO_DONE: {
+      const uint32_t time = this->echo_end_ - this->echo_start_;
+      if (time > this->timeout_us_) {
+        this->finish_measurement_(NAN);
+        return;
+      }
+      const float result = us_to_m(time);
+      ESP_LOGV(TAG, "Echo took %uµs (%fm)", time, result);
+      this->finish_measurement_(result);
+      return;
+    }
+    default:
+      if (micros() - this->trigger_time_ > this->timeout_us_) {
+        ESP_LOGV(TAG, "Timed out waiting for echo");
+        this->finish_measurement_(NAN);
+      }
+      return;
+  }
+}
+void UltrasonicSensorComponent::start_measurement_() {
+  this->measurement_requested_ = false;
+  active_ultrasonic_sensor = this;
+  last_ultrasonic_trigger = millis();
+  this->state_ = MeasurementState::WAITING_FOR_ECHO;
+
   this->trigger_pin_->digital_write(true);
   delayMicroseconds(this->pulse_time_us_);
   this->trigger_pin_->digital_write(false);
-  disable_interrupts();
-  uint32_t time = pulseIn(this->echo_pin_->get_pin(),
-                          uint8_t(!this->echo_pin_->is_inverted()),
-                          this->timeout_us_);
-  enable_interrupts();
-
-  float result = 0;
-  if (time == 0)
-    result = NAN;
-  else
-    result = us_to_m(time);
-
-  ESP_LOGV(TAG, "Echo took %uµs (%fm)", time, result);
-
+  this->trigger_time_ = micros();
+}
+void UltrasonicSensorComponent::finish_measurement_(float result) {
+  this->state_ = MeasurementState::IDLE;
+  active_ultrasonic_sensor = nullptr;
   this->publish_state(result);
 }
+void ICACHE_RAM_ATTR HOT UltrasonicSensorComponent::gpio_intr_() {
+  UltrasonicSensorComponent *sensor = active_ultrasonic_sensor;
+  if (sensor != nullptr)
+    sensor->on_interrupt_();
+}
+void ICACHE_RAM_ATTR HOT UltrasonicSensorComponent::on_interrupt_() {
+  const MeasurementState state = this->state_;
+  if (state != MeasurementState::WAITING_FOR_ECHO && state != MeasurementState::ECHO_HIGH)
+    return;
+
+  const uint32_t now = micros();
+  const bool level = this->echo_isr_pin_.digital_read();
+  if (level && state == MeasurementState::WAITING_FOR_ECHO) {
+    this->echo_start_ = now;
+    this->state_ = MeasurementState::ECHO_HIGH;
+  } else if (!level && state == MeasurementState::ECHO_HIGH) {
+    this->echo_end_ = now;
+    this->state_ = MeasurementState::ECHO_DONE;
+  }
+}
 uint32_t UltrasonicSensorComponent::get_timeout_us() const {
   return this->timeout_us_;
 }
@@ -83,10 +140,10 @@ uint32_t UltrasonicSensorComponent::get_pulse_time_us() const {
 void UltrasonicSensorComponent::set_pulse_time_us(uint32_t pulse_time_us) {
   this->pulse_time_us_ = pulse_time_us;
 }
-std::string UltrasonicSensorComponent::unit_of_measurement() {
+const char *UltrasonicSensorComponent::unit_of_measurement() {
   return "m";
 }
-std::string UltrasonicSensorComponent::icon() {
+const char *UltrasonicSensorComponent::icon() {
   return "mdi:arrow-expand-vertical";
 }
 int8_t UltrasonicSensorComponent::accuracy_decimals() {
@@ -25,6 +25,10 @@ const float SPEED_OF_SOUND_M_PER_US = 0.000343f;
  * meters). If this timeout is reached, the sensor reports a "nan" (not a number) float value. The timeout defaults to
  * 11662µs or 2m.
  *
+ * The echo is timed with an edge interrupt on the echo pin, so interrupts are never disabled and the main loop
+ * is not blocked while waiting for the echo. If multiple ultrasonic sensors are set up, they are triggered one
+ * after another (with a short pause in between for the previous echoes to die down) to avoid crosstalk.
+ *
  * Usually these would be like HC-SR04 ultrasonic sensors: one trigger pin for sending the signal and another one echo
  * pin for receiving the signal. Be very careful with that sensor though: it's made for 5v VCC and doesn't work
  * very well with the ESP's 3.3V, so you need to create a voltage divider in order to not damage your ESP.
@@ -60,10 +64,13 @@ class UltrasonicSensorComponent : public PollingSensorComponent {
   void setup() override;
   void dump_config() override;
 
+  /// Request a measurement, the sensor is triggered once no other ultrasonic sensor is measuring.
   void update() override;
+  /// Trigger requested measurements and publish finished ones.
+  void loop() override;
 
-  std::string unit_of_measurement() override;
-  std::string icon() override;
+  const char *unit_of_measurement() override;
+  const char *icon() override;
   int8_t accuracy_decimals() override;
 
   /// Hardware setup priority, before MQTT and WiFi.
@@ -80,10 +87,33 @@ class UltrasonicSensorComponent : public PollingSensorComponent {
   /// Helper function to convert the specified distance in meters to the echo duration in µs.
   static uint32_t m_to_us(float m);
 
+  /// Send the trigger pulse and start listening for the echo.
+  void start_measurement_();
+  /// Publish the result and let the next sensor measure.
+  void finish_measurement_(float result);
+
+  /// Record the echo edges of this sensor.
+  void on_interrupt_();
+  /// Shared interrupt handler of all ultrasonic sensors' echo pins, forwards to the measuring sensor.
+  static void gpio_intr_();
+
+  enum class MeasurementState {
+    IDLE,
+    WAITING_FOR_ECHO,
+    ECHO_HIGH,
+    ECHO_DONE,
+  };
+
   GPIOPin *trigger_pin_;
   GPIOPin *echo_pin_;
+  FastGPIO echo_isr_pin_;
   uint32_t timeout_us_{11662}; /// 2 meters.
   uint32_t pulse_time_us_{10};
+  bool measurement_requested_{false};
+  volatile MeasurementState state_{MeasurementState::IDLE};
+  uint32_t trigger_time_{0};
+  volatile uint32_t echo_start_{0};
+  volatile uint32_t echo_end_{0};
 };
 
 } // namespace sensor
@@ -33,10 +33,10 @@ void UptimeSensor::update() {
   const float seconds = float(seconds_int) + (this->uptime_ % 1000ULL) / 1000.0f;
   this->publish_state(seconds);
 }
-std::string UptimeSensor::unit_of_measurement() {
+const char *UptimeSensor::unit_of_measurement() {
   return "s";
 }
-std::string UptimeSensor::icon() {
+const char *UptimeSensor::icon() {
   return "mdi:timer";
 }
 int8_t UptimeSensor::accuracy_decimals() {
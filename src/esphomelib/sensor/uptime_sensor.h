@@ -17,8 +17,8 @@ class UptimeSensor : public PollingSensorComponent {
 
   void update() override;
 
-  std::string unit_of_measurement() override;
-  std::string icon() override;
+  const char *unit_of_measurement() override;
+  const char *icon() override;
   int8_t accuracy_decimals() override;
   std::string unique_id() override;
 
@@ -23,10 +23,10 @@ WiFiSignalSensor::WiFiSignalSensor(const std::string &name, uint32_t update_inte
 void WiFiSignalSensor::update() {
   this->publish_state(WiFi.RSSI());
 }
-std::string WiFiSignalSensor::unit_of_measurement() {
+const char *WiFiSignalSensor::unit_of_measurement() {
   return "dB";
 }
-std::string WiFiSignalSensor::icon() {
+const char *WiFiSignalSensor::icon() {
   return "mdi:wifi";
 }
 int8_t WiFiSignalSensor::accuracy_decimals() {
@@ -18,8 +18,8 @@ class WiFiSignalSensor : public PollingSensorComponent {
   void update() override;
   void dump_config() override;
 
-  std::string unit_of_measurement() override;
-  std::string icon() override;
+  const char *unit_of_measurement() override;
+  const char *icon() override;
   int8_t accuracy_decimals() override;
   std::string unique_id() override;
   float get_setup_priority() const override;
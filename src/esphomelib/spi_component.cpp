@@ -20,20 +20,20 @@ void ICACHE_RAM_ATTR HOT SPIComponent::write_byte(uint8_t data) {
   if (this->msb_first_)
     send_bits = reverse_bits_8(data);
 
-  this->clk_->digital_write(true);
+  this->clk_fast_.digital_write(true);
   if (!this->high_speed_)
     delayMicroseconds(5);
 
   for (size_t i = 0; i < 8; i++) {
     if (!this->high_speed_)
       delayMicroseconds(5);
-    this->clk_->digital_write(false);
+    this->clk_fast_.digital_write(false);
 
     // sampling on leading edge
-    this->mosi_->digital_write(send_bits & (1 << i));
+    this->mosi_fast_.digital_write(send_bits & (1 << i));
     if (!this->high_speed_)
       delayMicroseconds(5);
-    this->clk_->digital_write(true);
+    this->clk_fast_.digital_write(true);
   }
 
   ESP_LOGVV(TAG, "    Wrote 0b" BYTE_TO_BINARY_PATTERN " (0x%02X)",
@@ -41,17 +41,17 @@ void ICACHE_RAM_ATTR HOT SPIComponent::write_byte(uint8_t data) {
 }
 
 uint8_t ICACHE_RAM_ATTR HOT SPIComponent::read_byte() {
-  this->clk_->digital_write(true);
+  this->clk_fast_.digital_write(true);
 
   uint8_t data = 0;
   for (size_t i = 0; i < 8; i++) {
     if (!this->high_speed_)
       delayMicroseconds(5);
-    data |= uint8_t(this->miso_->digital_read()) << i;
-    this->clk_->digital_write(false);
+    data |= uint8_t(this->miso_fast_.digital_read()) << i;
+    this->clk_fast_.digital_write(false);
     if (!this->high_speed_)
       delayMicroseconds(5);
-    this->clk_->digital_write(true);
+    this->clk_fast_.digital_write(true);
   }
 
   if (this->msb_first_) {
@@ -93,12 +93,15 @@ void SPIComponent::setup() {
   ESP_LOGCONFIG(TAG, "Setting up SPI bus...");
   this->clk_->setup();
   this->clk_->digital_write(true);
+  this->clk_fast_ = this->clk_->to_fast_gpio();
   if (this->miso_ != nullptr) {
     this->miso_->setup();
+    this->miso_fast_ = this->miso_->to_fast_gpio();
   }
   if (this->mosi_ != nullptr) {
     this->mosi_->setup();
     this->mosi_->digital_write(false);
+    this->mosi_fast_ = this->mosi_->to_fast_gpio();
   }
 }
 void SPIComponent::dump_config() {
@@ -41,6 +41,9 @@ class SPIComponent : public Component {
   GPIOPin *miso_;
   GPIOPin *mosi_;
   GPIOPin *active_cs_{nullptr};
+  FastGPIO clk_fast_;
+  FastGPIO miso_fast_;
+  FastGPIO mosi_fast_;
   bool msb_first_{true};
   bool high_speed_{false};
 };
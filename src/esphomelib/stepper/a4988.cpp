@@ -21,6 +21,10 @@ void A4988::setup() {
   this->step_pin_->digital_write(false);
   this->dir_pin_->setup();
   this->dir_pin_->digital_write(false);
+
+#ifdef ARDUINO_ARCH_ESP32
+  this->setup_timer_stepping_(this->step_pin_, this->dir_pin_);
+#endif
 }
 void A4988::dump_config() {
   ESP_LOGCONFIG(TAG, "A4988:");
@@ -30,10 +34,17 @@ void A4988::dump_config() {
   LOG_STEPPER(this);
 }
 void A4988::loop() {
-  bool at_target = this->has_reached_target();
+  bool at_target = this->has_reached_target() && this->direction_ == 0;
   if (this->sleep_pin_ != nullptr) {
     this->sleep_pin_->digital_write(!at_target);
   }
+
+#ifdef ARDUINO_ARCH_ESP32
+  // Steps are generated by the stepper timer interrupt if both pins are internal GPIOs.
+  if (this->timer_stepping_)
+    return;
+#endif
+
   if (at_target) {
     this->high_freq_.stop();
   } else {
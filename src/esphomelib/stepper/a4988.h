@@ -13,6 +13,11 @@ ESPHOMELIB_NAMESPACE_BEGIN
 
 namespace stepper {
 
+/** A4988 step/dir driver.
+ *
+ * On the ESP32, the step pulses are generated by the shared stepper timer interrupt. On the ESP8266 both
+ * hardware timers are already in use (software serial and PWM), so steps are made from loop().
+ */
 class A4988 : public Stepper, public Component {
  public:
   A4988(GPIOPin *step_pin, GPIOPin *dir_pin);
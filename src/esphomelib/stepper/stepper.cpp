@@ -13,64 +13,305 @@ namespace stepper {
 
 static const char *TAG = "stepper";
 
-void Stepper::calculate_speed_(uint32_t now) {
-  // delta t since last calculation in seconds
-  float dt = (now - this->last_calculation_) * 1e-6f;
-  this->last_calculation_ = now;
-  if (this->has_reached_target()) {
-    this->current_speed_ = 0.0f;
-    return;
+/// The slowest step interval of the ramp (about 4s per step), in µs << 8. Keeps 2 * c from overflowing.
+static const uint32_t RAMP_C_MAX = 1UL << 30;
+
+#ifdef ARDUINO_ARCH_ESP32
+/// Guards the ramp parameters and the timer state shared with the stepper timer interrupt.
+static portMUX_TYPE stepper_mux = portMUX_INITIALIZER_UNLOCKED;
+#endif
+
+Stepper::Stepper() {
+  this->apply_profile_(this->acceleration_, this->deceleration_, this->max_speed_);
+}
+void Stepper::apply_profile_(float acceleration, float deceleration, float max_speed) {
+  // AVR446 eq. 15 with a 1 MHz timer, the 0.676 factor corrects the error of the approximation for the first step.
+  float c0 = 0.676f * 1e6f * sqrtf(2.0f / acceleration) * 256.0f;
+  float c_min = 1e6f / max_speed * 256.0f;
+  float n_max = (max_speed * max_speed) / (2.0f * acceleration);
+  const uint32_t ramp_c_min = uint32_t(clamp(256.0f, float(RAMP_C_MAX), c_min));
+  const uint32_t ramp_c0 = std::max(ramp_c_min, uint32_t(clamp(256.0f, float(RAMP_C_MAX), c0)));
+  const int32_t ramp_n_max = int32_t(clamp(1.0f, 1e9f, n_max));
+  const uint32_t accel_to_decel = uint32_t(clamp(1.0f, 4e9f, acceleration / deceleration * 65536.0f));
+  const uint32_t decel_to_accel = uint32_t(clamp(1.0f, 4e9f, deceleration / acceleration * 65536.0f));
+
+  // The timer interrupt must not see a half-updated profile.
+#ifdef ARDUINO_ARCH_ESP32
+  portENTER_CRITICAL(&stepper_mux);
+#endif
+  this->ramp_c_min_ = ramp_c_min;
+  this->ramp_c0_ = ramp_c0;
+  this->ramp_n_max_ = ramp_n_max;
+  this->accel_to_decel_ = accel_to_decel;
+  this->decel_to_accel_ = decel_to_accel;
+#ifdef ARDUINO_ARCH_ESP32
+  portEXIT_CRITICAL(&stepper_mux);
+#endif
+}
+uint32_t ICACHE_RAM_ATTR HOT Stepper::next_step_interval_() {
+  const int32_t distance = this->target_position - this->current_position;
+  int32_t steps_to_stop;
+  if (this->ramp_n_ >= 0) {
+    steps_to_stop = (int64_t(this->ramp_n_) * this->accel_to_decel_) >> 16;
+  } else {
+    steps_to_stop = -this->ramp_n_;
   }
 
-  int32_t num_steps = abs(int32_t(this->target_position) - int32_t(this->current_position));
-  // (v_0)^2 / 2*a
-  float v_squared = this->current_speed_ * this->current_speed_;
-  int32_t steps_to_decelerate = v_squared / (2 * this->deceleration_);
-  if (num_steps <= steps_to_decelerate) {
-    // need to start decelerating
-    this->current_speed_ -= this->deceleration_ * dt;
+  if (distance == 0 && steps_to_stop <= 1) {
+    this->ramp_n_ = 0;
+    this->direction_ = 0;
+    return 0;
+  }
+
+  const int8_t wanted = distance > 0 ? 1 : -1;
+  const int32_t abs_distance = distance > 0 ? distance : -distance;
+  if (this->ramp_n_ == 0) {
+    // Starting from standstill
+    this->direction_ = wanted;
+  } else if (this->ramp_n_ > 0) {
+    if (this->direction_ != wanted || steps_to_stop >= abs_distance) {
+      // Start decelerating
+      this->ramp_n_ = -steps_to_stop;
+      if (this->ramp_n_ == 0)
+        this->direction_ = wanted;
+    }
+  } else if (this->direction_ == wanted && steps_to_stop < abs_distance) {
+    // Decelerating, but the target moved away: accelerate again from the current speed
+    this->ramp_n_ = (int64_t(-this->ramp_n_) * this->decel_to_accel_) >> 16;
+  }
+
+  uint32_t c = this->ramp_c_;
+  if (this->ramp_n_ == 0) {
+    c = this->ramp_c0_;
+    this->ramp_n_ = 1;
+  } else if (this->ramp_n_ >= this->ramp_n_max_) {
+    c = this->ramp_c_min_;
   } else {
-    // we can still accelerate
-    this->current_speed_ += this->acceleration_ * dt;
+    // AVR446 eq. 13, (4n + 1) is negative while decelerating
+    if (this->ramp_n_ > 0) {
+      c -= (2 * c) / uint32_t(4 * this->ramp_n_ + 1);
+    } else {
+      c += (2 * c) / uint32_t(-4 * this->ramp_n_ - 1);
+    }
+    this->ramp_n_++;
   }
-  this->current_speed_ = clamp(0.0f, this->max_speed_, this->current_speed_);
+  if (c < this->ramp_c_min_)
+    c = this->ramp_c_min_;
+  if (c > RAMP_C_MAX)
+    c = RAMP_C_MAX;
+  this->ramp_c_ = c;
+
+  return std::max(c >> 8, uint32_t(1));
 }
 int32_t Stepper::should_step_() {
-  uint32_t now = micros();
-  this->calculate_speed_(now);
-  if (this->current_speed_ == 0.0f)
+  const uint32_t now = micros();
+  if (this->step_interval_ == 0) {
+    // Standing still, start moving once the target changes
+    this->step_interval_ = this->next_step_interval_();
+    this->last_step_ = now;
     return 0;
+  }
 
-  // assumes this method is called in a constant interval
-  uint32_t dt = now - this->last_step_;
-  if (dt >= (1 / this->current_speed_) * 1e6f) {
-    int32_t mag = this->target_position > this->current_position ? 1 : -1;
-    this->last_step_ = now;
-    this->current_position += mag;
-    return mag;
+  if (now - this->last_step_ < this->step_interval_)
+    return 0;
+
+  this->last_step_ = now;
+  const int32_t dir = this->direction_;
+  this->current_position += dir;
+  this->step_interval_ = this->next_step_interval_();
+  return dir;
+}
+
+#ifdef ARDUINO_ARCH_ESP32
+/// The hardware timer used for the step pulses of all steppers.
+static const uint8_t STEPPER_TIMER_NUM = 3;
+/// The length of the high phase and the minimum length of the low phase of a step pulse, in µs.
+static const uint32_t STEPPER_PULSE_US = 5;
+/// Events closer than this are handled right away, an alarm that close could be missed.
+static const uint32_t STEPPER_MIN_ALARM_US = 3;
+
+static Stepper *timer_steppers = nullptr;
+static hw_timer_t *stepper_timer = nullptr;
+/// Whether the timer alarm is armed, false while no stepper has a pending event.
+static bool stepper_alarm_armed = false;
+static uint64_t stepper_alarm = 0;
+
+static void ICACHE_RAM_ATTR arm_stepper_alarm(uint64_t at) {
+  stepper_alarm = at;
+  stepper_alarm_armed = true;
+  timerAlarmWrite(stepper_timer, at, false);
+  timerAlarmEnable(stepper_timer);
+}
+
+bool Stepper::setup_timer_stepping_(GPIOPin *step_pin, GPIOPin *dir_pin) {
+  this->isr_step_pin_ = step_pin->to_fast_gpio();
+  this->isr_dir_pin_ = dir_pin->to_fast_gpio();
+  if (this->isr_step_pin_.has_fallback() || this->isr_dir_pin_.has_fallback()) {
+    // Writing these pins can't be done from an interrupt (or with stepper_mux held).
+    ESP_LOGD(TAG, "Step or dir pin isn't an internal GPIO, stepping from the main loop.");
+    return false;
   }
 
-  return 0;
+  if (stepper_timer == nullptr) {
+    // 80 MHz APB clock / 80 = 1 µs resolution. The timer runs freely, one-shot alarms are set for the next event.
+    stepper_timer = timerBegin(STEPPER_TIMER_NUM, 80, true);
+    timerAttachInterrupt(stepper_timer, &Stepper::timer_intr_, true);
+  }
+  portENTER_CRITICAL(&stepper_mux);
+  this->timer_next_ = timer_steppers;
+  timer_steppers = this;
+  this->timer_stepping_ = true;
+  portEXIT_CRITICAL(&stepper_mux);
+  this->on_target_changed_();
+  return true;
 }
+void ICACHE_RAM_ATTR HOT Stepper::timer_intr_() {
+  portENTER_CRITICAL_ISR(&stepper_mux);
+  stepper_alarm_armed = false;
+  uint64_t now = timerRead(stepper_timer);
+  uint64_t next;
+  while (true) {
+    next = UINT64_MAX;
+    for (Stepper *stepper = timer_steppers; stepper != nullptr; stepper = stepper->timer_next_) {
+      if (!stepper->timer_active_)
+        continue;
+      if (stepper->timer_due_ <= now)
+        stepper->timer_event_(now);
+      if (stepper->timer_active_ && stepper->timer_due_ < next)
+        next = stepper->timer_due_;
+    }
+    if (next == UINT64_MAX)
+      break;
+    now = timerRead(stepper_timer);
+    if (next > now + STEPPER_MIN_ALARM_US)
+      break;
+  }
+  // With no pending event the alarm stays disabled until a stepper gets a new target.
+  if (next != UINT64_MAX)
+    arm_stepper_alarm(next);
+  portEXIT_CRITICAL_ISR(&stepper_mux);
+}
+void ICACHE_RAM_ATTR HOT Stepper::timer_event_(uint64_t now) {
+  if (this->step_high_) {
+    this->isr_step_pin_.digital_write(false);
+    this->step_high_ = false;
+    this->timer_due_ = this->step_due_;
+    return;
+  }
+
+  if (this->direction_ != 0) {
+    // The scheduled step is due
+    this->isr_step_pin_.digital_write(true);
+    this->step_high_ = true;
+    this->current_position += this->direction_;
+  }
+
+  const uint32_t interval = this->next_step_interval_();
+  if (interval == 0) {
+    if (this->step_high_) {
+      // End the pulse, and check the target once more after the low phase in case it changed in between.
+      this->step_due_ = now + 2 * STEPPER_PULSE_US;
+      this->timer_due_ = now + STEPPER_PULSE_US;
+    } else {
+      this->timer_active_ = false;
+    }
+    return;
+  }
+
+  this->isr_dir_pin_.digital_write(this->direction_ > 0);
+  // Schedule from the previous step so that the average step rate is exact, but leave room for the pulse.
+  uint64_t due = this->step_due_ + interval;
+  const uint64_t earliest = now + (this->step_high_ ? 2 * STEPPER_PULSE_US : STEPPER_MIN_ALARM_US);
+  if (due < earliest)
+    due = earliest;
+  this->step_due_ = due;
+  this->timer_due_ = this->step_high_ ? now + STEPPER_PULSE_US : due;
+}
+#endif
+
+void Stepper::on_target_changed_() {
+#ifdef ARDUINO_ARCH_ESP32
+  if (!this->timer_stepping_)
+    return;
+  portENTER_CRITICAL(&stepper_mux);
+  if (!this->timer_active_) {
+    // Let the interrupt compute the first step of the new move.
+    const uint64_t now = timerRead(stepper_timer);
+    this->timer_active_ = true;
+    this->timer_due_ = now;
+    this->step_due_ = now;
+    if (!stepper_alarm_armed || now + STEPPER_MIN_ALARM_US < stepper_alarm)
+      arm_stepper_alarm(now + STEPPER_MIN_ALARM_US);
+  }
+  portEXIT_CRITICAL(&stepper_mux);
+#endif
+}
+
 void Stepper::set_target(int32_t steps) {
+  if (this->profile_scaled_) {
+    this->apply_profile_(this->acceleration_, this->deceleration_, this->max_speed_);
+    this->profile_scaled_ = false;
+  }
   this->target_position = steps;
+  this->on_target_changed_();
 }
 void Stepper::report_position(int32_t steps) {
+  disable_interrupts();
   this->current_position = steps;
+  enable_interrupts();
+  this->on_target_changed_();
 }
 void Stepper::set_acceleration(float acceleration) {
   this->acceleration_ = acceleration;
+  this->apply_profile_(this->acceleration_, this->deceleration_, this->max_speed_);
 }
 void Stepper::set_deceleration(float deceleration) {
   this->deceleration_ = deceleration;
+  this->apply_profile_(this->acceleration_, this->deceleration_, this->max_speed_);
 }
 void Stepper::set_max_speed(float max_speed) {
   this->max_speed_ = max_speed;
+  this->apply_profile_(this->acceleration_, this->deceleration_, this->max_speed_);
 }
 bool Stepper::has_reached_target() {
   return this->current_position == this->target_position;
 }
 
+void move_coordinated(const std::vector<Stepper *> &steppers, const std::vector<int32_t> &targets) {
+  // The longest move sets the pace, the others are scaled down by their relative distance.
+  int32_t longest = 0;
+  for (size_t i = 0; i < steppers.size(); i++) {
+    longest = std::max(longest, abs(targets[i] - steppers[i]->current_position));
+  }
+
+  // Find the fastest profile of the longest move for which no stepper exceeds its own limits.
+  float acceleration = INFINITY;
+  float deceleration = INFINITY;
+  float max_speed = INFINITY;
+  for (size_t i = 0; i < steppers.size(); i++) {
+    Stepper *stepper = steppers[i];
+    int32_t distance = abs(targets[i] - stepper->current_position);
+    if (distance == 0)
+      continue;
+    float factor = longest / float(distance);
+    acceleration = std::min(acceleration, stepper->acceleration_ * factor);
+    deceleration = std::min(deceleration, stepper->deceleration_ * factor);
+    max_speed = std::min(max_speed, stepper->max_speed_ * factor);
+  }
+
+  for (size_t i = 0; i < steppers.size(); i++) {
+    Stepper *stepper = steppers[i];
+    int32_t distance = abs(targets[i] - stepper->current_position);
+    if (distance != 0) {
+      float factor = distance / float(longest);
+      stepper->apply_profile_(acceleration * factor, deceleration * factor, max_speed * factor);
+      stepper->profile_scaled_ = true;
+    }
+    stepper->target_position = targets[i];
+    stepper->on_target_changed_();
+  }
+}
+
 } // namespace stepper
 
 ESPHOMELIB_NAMESPACE_END
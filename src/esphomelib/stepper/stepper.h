@@ -7,6 +7,7 @@
 
 #include "esphomelib/component.h"
 #include "esphomelib/automation.h"
+#include "esphomelib/esphal.h"
 
 ESPHOMELIB_NAMESPACE_BEGIN
 
@@ -23,8 +24,22 @@ class ReportPositionAction;
     ESP_LOGCONFIG(TAG, "  Deceleration: %.0f steps/s^2", this->deceleration_); \
     ESP_LOGCONFIG(TAG, "  Max Speed: %.0f steps/s", this->max_speed_);
 
+/** Base class for steppers with a trapezoidal speed profile.
+ *
+ * The profile is computed step by step with the integer approximation from Atmel AVR446 ("Linear speed
+ * control of stepper motor"): the interval to the next step is c_n = c_{n-1} - 2 * c_{n-1} / (4n + 1), with
+ * negative n while decelerating. This only needs integer math, so it can run in an interrupt.
+ *
+ * Step/dir drivers can either call should_step_() from their loop(), or on the ESP32 let the shared stepper
+ * timer interrupt generate the step pulses with setup_timer_stepping_(), so the step rate doesn't depend on
+ * the main loop. The timer only fires when a step edge is due, and not at all while every stepper is idle.
+ * Only internal GPIOs can be driven from the interrupt, steppers on other pins (like I/O expanders) must keep
+ * using should_step_().
+ */
 class Stepper {
  public:
+  Stepper();
+
   void set_target(int32_t steps);
   void report_position(int32_t steps);
   void set_acceleration(float acceleration);
@@ -37,21 +52,80 @@ class Stepper {
   template<typename T>
   ReportPositionAction<T> *make_report_position_action();
 
-  int32_t current_position{0};
-  int32_t target_position{0};
+  volatile int32_t current_position{0};
+  volatile int32_t target_position{0};
 
  protected:
-  void calculate_speed_(uint32_t now);
+  friend void move_coordinated(const std::vector<Stepper *> &steppers, const std::vector<int32_t> &targets);
+
+  /// Compute the integer profile parameters for these limits (steps/s^2 and steps/s).
+  void apply_profile_(float acceleration, float deceleration, float max_speed);
+  /** Advance the speed profile by one step.
+   *
+   * @return The time in µs until the next step should be made in direction_, or 0 if the stepper stopped.
+   */
+  uint32_t next_step_interval_();
+  /// For loop() based drivers: return the direction of the step to make now, or 0.
   int32_t should_step_();
+  /// Called when the target or position changed, wakes up the timer of an idle stepper.
+  void on_target_changed_();
+
+#ifdef ARDUINO_ARCH_ESP32
+  /** Generate the step pulses for this stepper from the shared stepper timer interrupt.
+   *
+   * @return Whether the timer is used, false if a pin isn't an internal GPIO and can't be written from an interrupt.
+   */
+  bool setup_timer_stepping_(GPIOPin *step_pin, GPIOPin *dir_pin);
+  /// Handle the due step edge of this stepper and compute when the next one is due.
+  void timer_event_(uint64_t now);
+
+  static void timer_intr_();
+
+  FastGPIO isr_step_pin_;
+  FastGPIO isr_dir_pin_;
+  bool timer_stepping_{false};
+  /// Whether the timer has an event of this stepper pending.
+  bool timer_active_{false};
+  /// Timer time (µs) of the next event of this stepper, the end of a step pulse or the next step.
+  uint64_t timer_due_{0};
+  /// Timer time (µs) of the next step, steps are scheduled from the previous one so that the rate is exact.
+  uint64_t step_due_{0};
+  bool step_high_{false};
+  Stepper *timer_next_{nullptr};
+#endif
 
   float acceleration_{1e6f};
   float deceleration_{1e6f};
-  float current_speed_{0.0f};
   float max_speed_{1e6f};
-  uint32_t last_calculation_{0};
+  bool profile_scaled_{false};
+
+  /// The first step interval from standstill, in µs << 8.
+  uint32_t ramp_c0_{0};
+  /// The step interval at maximum speed, in µs << 8.
+  uint32_t ramp_c_min_{0};
+  /// The number of acceleration steps needed to reach the maximum speed.
+  int32_t ramp_n_max_{0};
+  /// acceleration / deceleration and the inverse, as 16.16 fixed point.
+  uint32_t accel_to_decel_{65536};
+  uint32_t decel_to_accel_{65536};
+
+  /// The position on the ramp, positive while accelerating and negative while decelerating.
+  int32_t ramp_n_{0};
+  /// The current step interval, in µs << 8.
+  uint32_t ramp_c_{0};
+  int8_t direction_{0};
+  uint32_t step_interval_{0};
   uint32_t last_step_{0};
 };
 
+/** Move several steppers so that they start and arrive at the same time.
+ *
+ * The acceleration, deceleration and speed limits of each stepper are scaled by its distance relative to the
+ * longest move, so all position profiles are proportional. The steppers should be standing still. The next
+ * set_target() on a stepper restores its own limits.
+ */
+void move_coordinated(const std::vector<Stepper *> &steppers, const std::vector<int32_t> &targets);
+
 template<typename T>
 class SetTargetAction : public Action<T> {
  public:
@@ -83,11 +157,11 @@ class ReportPositionAction : public Action<T> {
 };
 template<typename T>
 void ReportPositionAction<T>::set_position(std::function<int32_t(T)> pos) {
-  this->target_ = std::move(pos);
+  this->pos_ = std::move(pos);
 }
 template<typename T>
 void ReportPositionAction<T>::set_position(int32_t pos) {
-  this->target_ = pos;
+  this->pos_ = pos;
 }
 template<typename T>
 ReportPositionAction<T>::ReportPositionAction(Stepper *parent)
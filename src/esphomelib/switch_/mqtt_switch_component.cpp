@@ -53,8 +53,9 @@ std::string MQTTSwitchComponent::component_type() const {
   return "switch";
 }
 void MQTTSwitchComponent::send_discovery(JsonObject &root, mqtt::SendDiscoveryConfig &config) {
-  if (!this->switch_->get_icon().empty())
-    root["icon"] = this->switch_->get_icon();
+  const char *icon = this->switch_->get_icon();
+  if (icon[0] != '\0')
+    root["icon"] = icon;
   if (this->switch_->optimistic())
     root["optimistic"] = true;
 }
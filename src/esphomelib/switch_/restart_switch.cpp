@@ -12,7 +12,7 @@ namespace switch_ {
 
 static const char *TAG = "switch.restart";
 
-std::string RestartSwitch::icon() {
+const char *RestartSwitch::icon() {
   return "mdi:restart";
 }
 RestartSwitch::RestartSwitch(const std::string &name)
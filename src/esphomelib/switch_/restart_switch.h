@@ -15,7 +15,7 @@ class RestartSwitch : public Switch, public Component {
  public:
   explicit RestartSwitch(const std::string &name);
 
-  std::string icon() override;
+  const char *icon() override;
 
   void dump_config() override;
 
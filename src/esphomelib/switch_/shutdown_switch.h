@@ -15,7 +15,7 @@ class ShutdownSwitch : public Switch, public Component {
  public:
   explicit ShutdownSwitch(const std::string &name);
 
-  std::string icon() override;
+  const char *icon() override;
 
   void dump_config() override;
  protected:
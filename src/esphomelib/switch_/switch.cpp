@@ -12,7 +12,7 @@ namespace switch_ {
 
 static const char *TAG = "switch";
 
-std::string Switch::icon() {
+const char *Switch::icon() {
   return "";
 }
 Switch::Switch(const std::string &name)
@@ -20,9 +20,9 @@ Switch::Switch(const std::string &name)
 
 }
 
-std::string Switch::get_icon() {
+const char *Switch::get_icon() {
   if (this->icon_.has_value())
-    return *this->icon_;
+    return this->icon_->c_str();
   return this->icon();
 }
 
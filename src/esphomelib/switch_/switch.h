@@ -26,8 +26,8 @@ class SwitchCondition;
 #define LOG_SWITCH(prefix, type, obj) \
     if (obj != nullptr) { \
       ESP_LOGCONFIG(TAG, prefix type " '%s'", obj->get_name().c_str()); \
-      if (!obj->get_icon().empty()) { \
-        ESP_LOGCONFIG(TAG, prefix "  Icon: '%s'", obj->get_icon().c_str()); \
+      if (obj->get_icon()[0] != '\0') { \
+        ESP_LOGCONFIG(TAG, prefix "  Icon: '%s'", obj->get_icon()); \
       } \
       if (obj->optimistic()) { \
         ESP_LOGCONFIG(TAG, prefix "  Optimistic: YES"); \
@@ -92,7 +92,7 @@ class Switch : public Nameable {
   void set_icon(const std::string &icon);
 
   /// Get the icon for this switch. Using icon() if not manually set
-  std::string get_icon();
+  const char *get_icon();
 
   template<typename T>
   ToggleAction<T> *make_toggle_action();
@@ -139,7 +139,7 @@ class Switch : public Nameable {
    *
    * @return The icon of this switch, for example "mdi:fan".
    */
-  virtual std::string icon();
+  virtual const char *icon();
 
   uint32_t hash_base_() override;
 
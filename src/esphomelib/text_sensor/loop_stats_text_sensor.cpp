@@ -0,0 +1,50 @@
+#include "esphomelib/defines.h"
+
+#ifdef USE_LOOP_STATS_TEXT_SENSOR
+
+#include "esphomelib/text_sensor/loop_stats_text_sensor.h"
+#include "esphomelib/log.h"
+#include "esphomelib/application.h"
+
+ESPHOMELIB_NAMESPACE_BEGIN
+
+namespace text_sensor {
+
+static const char *TAG = "text_sensor.loop_stats";
+
+LoopStatsTextSensor::LoopStatsTextSensor(const std::string &name, uint32_t update_interval)
+    : TextSensor(name), PollingComponent(update_interval) {}
+
+void LoopStatsTextSensor::update() {
+  const LoopStats &stats = App.get_loop_stats();
+  if (stats.iterations == 0)
+    return;
+
+  char buf[160];
+  snprintf(buf, sizeof(buf), "loop p50<%uus p99<%uus, interval p50<%uus p99<%uus, stall %uus (component %d), "
+                             "wdt margin %ums",
+           stats.percentile_us(stats.duration, 0.5f), stats.percentile_us(stats.duration, 0.99f),
+           stats.percentile_us(stats.interval, 0.5f), stats.percentile_us(stats.interval, 0.99f),
+           stats.longest_stall_us, stats.longest_stall_component, stats.min_watchdog_margin_us() / 1000);
+  App.reset_loop_stats();
+  this->publish_state(buf);
+}
+void LoopStatsTextSensor::dump_config() {
+  LOG_TEXT_SENSOR("", "Loop Stats Text Sensor", this);
+  LOG_UPDATE_INTERVAL(this);
+}
+float LoopStatsTextSensor::get_setup_priority() const {
+  return setup_priority::HARDWARE_LATE;
+}
+const char *LoopStatsTextSensor::icon() {
+  return "mdi:timer";
+}
+std::string LoopStatsTextSensor::unique_id() {
+  return get_mac_address() + "-loop-stats";
+}
+
+} // namespace text_sensor
+
+ESPHOMELIB_NAMESPACE_END
+
+#endif //USE_LOOP_STATS_TEXT_SENSOR
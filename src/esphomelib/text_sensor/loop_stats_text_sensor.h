@@ -0,0 +1,38 @@
+#ifndef ESPHOMELIB_TEXT_SENSOR_LOOP_STATS_TEXT_SENSOR_H
+#define ESPHOMELIB_TEXT_SENSOR_LOOP_STATS_TEXT_SENSOR_H
+
+#include "esphomelib/defines.h"
+
+#ifdef USE_LOOP_STATS_TEXT_SENSOR
+
+#include "esphomelib/component.h"
+#include "esphomelib/text_sensor/text_sensor.h"
+
+ESPHOMELIB_NAMESPACE_BEGIN
+
+namespace text_sensor {
+
+/** Periodically publish a summary of the loop latency statistics of the Application.
+ *
+ * Each report covers the time since the previous one: the median and 99th percentile loop duration and interval,
+ * the longest stall with the number of the component (in the order of the config dump) that caused it and how
+ * close the watchdog came to firing.
+ */
+class LoopStatsTextSensor : public TextSensor, public PollingComponent {
+ public:
+  LoopStatsTextSensor(const std::string &name, uint32_t update_interval = 60000);
+
+  void update() override;
+  void dump_config() override;
+  float get_setup_priority() const override;
+  const char *icon() override;
+  std::string unique_id() override;
+};
+
+} // namespace text_sensor
+
+ESPHOMELIB_NAMESPACE_END
+
+#endif //USE_LOOP_STATS_TEXT_SENSOR
+
+#endif //ESPHOMELIB_TEXT_SENSOR_LOOP_STATS_TEXT_SENSOR_H
@@ -16,8 +16,9 @@ MQTTTextSensor::MQTTTextSensor(TextSensor *sensor)
 
 }
 void MQTTTextSensor::send_discovery(JsonObject &root, mqtt::SendDiscoveryConfig &config) {
-  if (!this->sensor_->get_icon().empty())
-    root["icon"] = this->sensor_->get_icon();
+  const char *icon = this->sensor_->get_icon();
+  if (icon[0] != '\0')
+    root["icon"] = icon;
 
   if (!this->sensor_->unique_id().empty())
     root["unique_id"] = this->sensor_->unique_id();
@@ -23,12 +23,12 @@ void TextSensor::set_icon(const std::string &icon) {
 void TextSensor::add_on_state_callback(std::function<void(std::string)> callback) {
   this->callback_.add(std::move(callback));
 }
-std::string TextSensor::get_icon() {
+const char *TextSensor::get_icon() {
   if (this->icon_.has_value())
-    return *this->icon_;
+    return this->icon_->c_str();
   return this->icon();
 }
-std::string TextSensor::icon() {
+const char *TextSensor::icon() {
   return "";
 }
 std::string TextSensor::unique_id() {
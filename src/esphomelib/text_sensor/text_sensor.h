@@ -18,8 +18,8 @@ class TextSensorStateTrigger;
 #define LOG_TEXT_SENSOR(prefix, type, obj) \
     if (obj != nullptr) { \
       ESP_LOGCONFIG(TAG, prefix type " '%s'", obj->get_name().c_str()); \
-      if (!obj->get_icon().empty()) { \
-        ESP_LOGCONFIG(TAG, prefix "  Icon: '%s'", obj->get_icon().c_str()); \
+      if (obj->get_icon()[0] != '\0') { \
+        ESP_LOGCONFIG(TAG, prefix "  Icon: '%s'", obj->get_icon()); \
       } \
       if (!obj->unique_id().empty()) { \
         ESP_LOGV(TAG, prefix "  Unique ID: '%s'", obj->unique_id().c_str()); \
@@ -40,9 +40,9 @@ class TextSensor : public Nameable {
 
   // ========== INTERNAL METHODS ==========
   // (In most use cases you won't need these)
-  std::string get_icon();
+  const char *get_icon();
 
-  virtual std::string icon();
+  virtual const char *icon();
 
   virtual std::string unique_id();
 
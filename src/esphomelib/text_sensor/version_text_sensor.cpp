@@ -24,7 +24,7 @@ float VersionTextSensor::get_setup_priority() const {
 }
 VersionTextSensor::VersionTextSensor(const std::string &name) : TextSensor(name) {}
 
-std::string VersionTextSensor::icon() {
+const char *VersionTextSensor::icon() {
   return "mdi:new-box";
 }
 std::string VersionTextSensor::unique_id() {
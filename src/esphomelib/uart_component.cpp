@@ -233,104 +233,185 @@ void UARTComponent::flush() {
   }
 }
 
+/// All software serial instances with a TX pin, serviced by the shared timer0 interrupt.
+static ESP8266SoftwareSerial *tx_instances = nullptr;
+/// TX bits that are due within this many cycles are put on the line right away instead of re-arming the timer.
+static const uint32_t TX_TIMER_SLACK = F_CPU / 1000000UL;
+/// Minimum distance of the timer0 compare value from the current cycle count so that it can't be missed.
+static const uint32_t TX_TIMER_MIN_DELTA = F_CPU / 500000UL;
+
 void ESP8266SoftwareSerial::setup(int8_t tx_pin, int8_t rx_pin, uint32_t baud_rate) {
   this->bit_time_ = F_CPU / baud_rate;
   if (tx_pin != -1) {
     this->tx_mask_ = (1U << tx_pin);
     pinMode(tx_pin, OUTPUT);
-    this->tx_high_();
+    GPOS = this->tx_mask_;
+    this->tx_buffer_ = new uint8_t[this->tx_buffer_size_];
+    if (tx_instances == nullptr) {
+      timer0_isr_init();
+      timer0_attachInterrupt(&ESP8266SoftwareSerial::tx_timer_intr_);
+    }
+    disable_interrupts();
+    this->tx_next_instance_ = tx_instances;
+    tx_instances = this;
+    enable_interrupts();
   }
   if (rx_pin != -1) {
     this->rx_mask_ = (1U << rx_pin);
     pinMode(rx_pin, INPUT);
     this->rx_buffer_ = new uint8_t[this->rx_buffer_size_];
     auto f = std::bind(&ESP8266SoftwareSerial::gpio_intr_, this);
-    attachInterrupt(rx_pin, f, FALLING);
+    attachInterrupt(rx_pin, f, CHANGE);
   }
 }
 
 void ICACHE_RAM_ATTR HOT ESP8266SoftwareSerial::gpio_intr_() {
-  uint32_t wait = this->bit_time_ + this->bit_time_/3 - 500;
-  const uint32_t start = ESP.getCycleCount();
-  uint8_t rec = 0;
-  // Manually unroll the loop
-  rec |= this->read_bit_(wait, start) << 0;
-  rec |= this->read_bit_(wait, start) << 1;
-  rec |= this->read_bit_(wait, start) << 2;
-  rec |= this->read_bit_(wait, start) << 3;
-  rec |= this->read_bit_(wait, start) << 4;
-  rec |= this->read_bit_(wait, start) << 5;
-  rec |= this->read_bit_(wait, start) << 6;
-  rec |= this->read_bit_(wait, start) << 7;
-  // Stop bit
-  this->wait_(wait, start);
+  const uint32_t now = ESP.getCycleCount();
+  const bool level = (GPI & this->rx_mask_) != 0;
+  // Up until this edge the line had the opposite level.
+  this->rx_bits_(now, !level);
+  if (this->rx_bit_ == -1 && !level) {
+    // Falling edge while idle -> start bit
+    this->rx_bit_ = 0;
+    this->rx_byte_ = 0;
+  }
+  this->rx_last_edge_ = now;
+}
+void ICACHE_RAM_ATTR HOT ESP8266SoftwareSerial::rx_bits_(uint32_t now, bool level) {
+  int8_t bit = this->rx_bit_;
+  if (bit == -1)
+    return;
 
-  this->rx_buffer_[this->rx_in_pos_] = rec;
-  this->rx_in_pos_ = (this->rx_in_pos_ + 1) % this->rx_buffer_size_;
-  // Clear RX pin so that the interrupt doesn't re-trigger right away again.
-  GPIO_REG_WRITE(GPIO_STATUS_W1TC_ADDRESS, this->rx_mask_);
+  uint8_t rec = this->rx_byte_;
+  // Number of bit periods since the last edge, rounded to the nearest bit
+  uint32_t bits = (now - this->rx_last_edge_ + this->bit_time_ / 2) / this->bit_time_;
+  while (bits > 0 && bit != -1) {
+    bits--;
+    if (bit == 0) {
+      // Start bit
+      bit++;
+    } else if (bit <= 8) {
+      if (level)
+        rec |= 1U << (bit - 1);
+      bit++;
+    } else {
+      // Stop bit, discard the byte on framing errors and when the buffer is full
+      const size_t next = (this->rx_in_pos_ + 1) % this->rx_buffer_size_;
+      if (level && next != this->rx_out_pos_) {
+        this->rx_buffer_[this->rx_in_pos_] = rec;
+        this->rx_in_pos_ = next;
+      }
+      bit = -1;
+    }
+  }
+  this->rx_byte_ = rec;
+  this->rx_bit_ = bit;
 }
-void ICACHE_RAM_ATTR HOT ESP8266SoftwareSerial::write_byte(uint8_t data) {
+void ESP8266SoftwareSerial::rx_finish_pending_() {
+  disable_interrupts();
+  const int8_t bit = this->rx_bit_;
+  if (bit != -1) {
+    const uint32_t now = ESP.getCycleCount();
+    // The frame can only be finished without another edge once its stop bit has passed.
+    if (now - this->rx_last_edge_ >= (10 - bit) * this->bit_time_) {
+      this->rx_bits_(now, (GPI & this->rx_mask_) != 0);
+    }
+  }
+  enable_interrupts();
+}
+void ESP8266SoftwareSerial::write_byte(uint8_t data) {
   if (this->tx_mask_ == 0) {
     ESP_LOGE(TAG, "UART doesn't have TX pins set!");
     return;
   }
 
+  const size_t next = (this->tx_in_pos_ + 1) % this->tx_buffer_size_;
+  // Buffer full, wait for the timer interrupt to make room
+  while (next == this->tx_out_pos_)
+    yield();
+
+  this->tx_buffer_[this->tx_in_pos_] = data;
   disable_interrupts();
-  uint32_t wait = this->bit_time_;
-  const uint32_t start = ESP.getCycleCount();
-  // Start bit
-  this->write_bit_(false, wait, start);
-  this->write_bit_(data & (1 << 0), wait, start);
-  this->write_bit_(data & (1 << 1), wait, start);
-  this->write_bit_(data & (1 << 2), wait, start);
-  this->write_bit_(data & (1 << 3), wait, start);
-  this->write_bit_(data & (1 << 4), wait, start);
-  this->write_bit_(data & (1 << 5), wait, start);
-  this->write_bit_(data & (1 << 6), wait, start);
-  this->write_bit_(data & (1 << 7), wait, start);
-  // Stop bit
-  this->write_bit_(true, wait, start);
+  this->tx_in_pos_ = next;
+  if (!this->tx_active_) {
+    // Line is idle, put the start bit on the line right away.
+    this->tx_active_ = true;
+    this->tx_due_ = ESP.getCycleCount();
+    this->tx_next_bit_();
+    ESP8266SoftwareSerial::tx_schedule_();
+  }
   enable_interrupts();
 }
-void ESP8266SoftwareSerial::wait_(uint32_t &wait, const uint32_t &start) {
-  while (ESP.getCycleCount() - start < wait);
-  wait += this->bit_time_;
-}
-uint8_t ESP8266SoftwareSerial::read_bit_(uint32_t &wait, const uint32_t &start) {
-  this->wait_(wait, start);
-  return uint8_t((GPI & this->rx_mask_) != 0);
-}
-void ESP8266SoftwareSerial::write_bit_(bool bit, uint32_t &wait, const uint32_t &start) {
-  if (bit) {
-    this->tx_high_();
+void ICACHE_RAM_ATTR HOT ESP8266SoftwareSerial::tx_next_bit_() {
+  if (this->tx_bit_ == 10) {
+    // The stop bit of the last frame has been held for a full bit period, load the next byte.
+    if (this->tx_out_pos_ == this->tx_in_pos_) {
+      this->tx_active_ = false;
+      return;
+    }
+    this->tx_frame_ = (uint16_t(this->tx_buffer_[this->tx_out_pos_]) << 1) | (1U << 9);
+    this->tx_out_pos_ = (this->tx_out_pos_ + 1) % this->tx_buffer_size_;
+    this->tx_bit_ = 0;
+  }
+
+  if (this->tx_frame_ & (1U << this->tx_bit_)) {
+    GPOS = this->tx_mask_;
   } else {
-    this->tx_low_();
+    GPOC = this->tx_mask_;
   }
-  this->wait_(wait, start);
-}
-void ESP8266SoftwareSerial::tx_high_() {
-  GPOS = this->tx_mask_;
-}
-void ESP8266SoftwareSerial::tx_low_() {
-  GPOC = this->tx_mask_;
+  this->tx_bit_++;
+  this->tx_due_ += this->bit_time_;
+}
+void ICACHE_RAM_ATTR HOT ESP8266SoftwareSerial::tx_timer_intr_() {
+  const uint32_t now = ESP.getCycleCount();
+  for (auto *serial = tx_instances; serial != nullptr; serial = serial->tx_next_instance_) {
+    if (serial->tx_active_ && int32_t(serial->tx_due_ - now) < int32_t(TX_TIMER_SLACK))
+      serial->tx_next_bit_();
+  }
+  ESP8266SoftwareSerial::tx_schedule_();
+}
+void ICACHE_RAM_ATTR HOT ESP8266SoftwareSerial::tx_schedule_() {
+  bool any_active = false;
+  uint32_t next = 0;
+  for (auto *serial = tx_instances; serial != nullptr; serial = serial->tx_next_instance_) {
+    if (!serial->tx_active_)
+      continue;
+    if (!any_active || int32_t(serial->tx_due_ - next) < 0)
+      next = serial->tx_due_;
+    any_active = true;
+  }
+  if (!any_active)
+    return;
+
+  // A compare value in the past would only trigger after the cycle counter wraps around.
+  const uint32_t min_next = ESP.getCycleCount() + TX_TIMER_MIN_DELTA;
+  if (int32_t(next - min_next) < 0)
+    next = min_next;
+  timer0_write(next);
 }
 uint8_t ESP8266SoftwareSerial::read_byte() {
-  if (this->rx_in_pos_ == this->rx_out_pos_)
+  if (this->available() == 0)
     return 0;
   uint8_t data = this->rx_buffer_[this->rx_out_pos_];
   this->rx_out_pos_ = (this->rx_out_pos_ + 1) % this->rx_buffer_size_;
   return data;
 }
 uint8_t ESP8266SoftwareSerial::peek_byte() {
-  if (this->rx_in_pos_ == this->rx_out_pos_)
+  if (this->available() == 0)
     return 0;
   return this->rx_buffer_[this->rx_out_pos_];
 }
 void ESP8266SoftwareSerial::flush() {
+  // Wait for the TX buffer to drain
+  while (this->tx_active_)
+    yield();
   this->rx_in_pos_ = this->rx_out_pos_ = 0;
 }
 int ESP8266SoftwareSerial::available() {
+  if (this->rx_buffer_ == nullptr)
+    return 0;
+  if (this->rx_bit_ != -1)
+    this->rx_finish_pending_();
   int avail = int(this->rx_in_pos_) - int(this->rx_out_pos_);
   if (avail < 0)
     return avail + this->rx_buffer_size_;
@@ -11,6 +11,18 @@
 ESPHOMELIB_NAMESPACE_BEGIN
 
 #ifdef ARDUINO_ARCH_ESP8266
+/** Interrupt-driven software UART for the ESP8266.
+ *
+ * RX is decoded from edge timestamps: a CHANGE interrupt on the RX pin stores the CPU cycle count of each
+ * edge and fills in the bits that have passed since the previous edge. Trailing high bits of a frame
+ * (which don't produce an edge) are completed lazily in available().
+ *
+ * TX bytes are put into a ring buffer and shifted out one bit per timer0 (CCOMPARE0) interrupt. timer0
+ * is shared between all software serial instances, timer1 is left to the core waveform generator
+ * (used by ESP8266PWMOutput).
+ *
+ * No ISR blocks for longer than a few µs and interrupts are never disabled for a whole byte.
+ */
 class ESP8266SoftwareSerial {
  public:
   void setup(int8_t tx_pin, int8_t rx_pin, uint32_t baud_rate);
@@ -26,20 +38,41 @@ class ESP8266SoftwareSerial {
 
  protected:
   void gpio_intr_();
+  /// Feed the bits between the last edge and `now` into the RX frame. Must be called with interrupts off.
+  void rx_bits_(uint32_t now, bool level);
+  /// Complete a pending RX frame whose trailing bits were all high (no edge marks its end).
+  void rx_finish_pending_();
+  /// Shift out the next TX bit, called from the shared timer0 interrupt.
+  void tx_next_bit_();
 
-  inline void wait_(uint32_t &wait, const uint32_t &start);
-  inline uint8_t read_bit_(uint32_t &wait, const uint32_t &start);
-  inline void write_bit_(bool bit, uint32_t &wait, const uint32_t &start);
-  inline void tx_high_();
-  inline void tx_low_();
+  static void tx_timer_intr_();
+  /// Arm timer0 for the earliest pending TX bit of all instances.
+  static void tx_schedule_();
 
   uint32_t rx_mask_{0};
   uint32_t tx_mask_{0};
   uint32_t bit_time_{0};
+
   uint8_t *rx_buffer_{nullptr};
   size_t rx_buffer_size_{64};
   volatile size_t rx_in_pos_{0};
   size_t rx_out_pos_{0};
+  /// Bit index in the current RX frame (0 = start bit, 1-8 = data, 9 = stop), -1 when idle.
+  volatile int8_t rx_bit_{-1};
+  volatile uint8_t rx_byte_{0};
+  volatile uint32_t rx_last_edge_{0};
+
+  uint8_t *tx_buffer_{nullptr};
+  size_t tx_buffer_size_{64};
+  volatile size_t tx_in_pos_{0};
+  volatile size_t tx_out_pos_{0};
+  /// The frame (start, 8 data and stop bit) currently being shifted out, LSB first.
+  volatile uint16_t tx_frame_{0};
+  volatile uint8_t tx_bit_{10};
+  volatile bool tx_active_{false};
+  /// The cycle count at which the next TX bit should be put on the line.
+  volatile uint32_t tx_due_{0};
+  ESP8266SoftwareSerial *tx_next_instance_{nullptr};
 };
 #endif
 
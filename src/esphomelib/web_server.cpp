@@ -307,8 +307,11 @@ std::string WebServer::sensor_json(sensor::Sensor *obj, float value) {
   return build_json([obj, value](JsonObject &root) {
     root["id"] = "sensor-" + obj->get_object_id();
     std::string state = value_accuracy_to_string(value, obj->get_accuracy_decimals());
-    if (!obj->get_unit_of_measurement().empty())
-      state += " " + obj->get_unit_of_measurement();
+    const char *unit = obj->get_unit_of_measurement();
+    if (unit[0] != '\0') {
+      state += " ";
+      state += unit;
+    }
     root["state"] = state;
     root["value"] = value;
   });
@@ -16,6 +16,7 @@
 #include "esphomelib/log.h"
 #include "esphomelib/esphal.h"
 #include "esphomelib/api/api_server.h"
+#include "esphomelib/deep_sleep_component.h"
 
 #ifdef ARDUINO_ARCH_ESP32
 #include <ESPmDNS.h>
@@ -50,11 +51,22 @@ void WiFiComponent::setup() {
     delay(10);
 
     this->wifi_apply_power_save_();
-    this->start_scanning();
+    bool connecting = false;
+#ifdef USE_DEEP_SLEEP
+    connecting = this->start_fast_wake_connecting_();
+#endif
+    if (!connecting)
+      this->start_scanning();
   } else if (this->has_ap()) {
     this->setup_ap_config();
   }
 
+#ifdef USE_DEEP_SLEEP
+  // Nobody needs to find us during the few seconds we're awake to publish states.
+  if (global_deep_sleep != nullptr && global_deep_sleep->is_warm_wake())
+    return;
+#endif
+
   MDNS.begin(this->hostname_.c_str());
 #ifdef USE_API
   if (api::global_api_server != nullptr) {
@@ -243,6 +255,51 @@ void WiFiComponent::print_connect_params_() {
   ESP_LOGCONFIG(TAG, "  DNS2: %s", WiFi.dnsIP(1).toString().c_str());
 }
 
+#ifdef USE_DEEP_SLEEP
+bool WiFiComponent::start_fast_wake_connecting_() {
+  if (global_deep_sleep == nullptr || !global_deep_sleep->is_warm_wake())
+    return false;
+  FastWakeState *state = global_deep_sleep->get_fast_wake_state();
+  for (auto &sta : this->sta_) {
+    if (fnv1_hash(sta.get_ssid().c_str()) != state->ssid_hash)
+      continue;
+
+    WiFiAP ap = sta;
+    bssid_t bssid;
+    std::copy(state->bssid, state->bssid + 6, bssid.begin());
+    ap.set_bssid(bssid);
+    ap.set_channel(state->channel);
+    if (!ap.get_manual_ip().has_value() && state->ip != 0) {
+      // Reuse the DHCP lease from before deep sleep. If connecting fails, the next attempt scans and uses DHCP.
+      ap.set_manual_ip(ManualIP{
+          .static_ip = IPAddress(state->ip),
+          .gateway = IPAddress(state->gateway),
+          .subnet = IPAddress(state->subnet),
+          .dns1 = IPAddress(state->dns1),
+          .dns2 = IPAddress(state->dns2),
+      });
+    }
+    ESP_LOGD(TAG, "Reconnecting to the access point from before deep sleep...");
+    this->start_connecting(ap);
+    return true;
+  }
+  return false;
+}
+void WiFiComponent::save_fast_wake_state_() {
+  if (global_deep_sleep == nullptr || global_deep_sleep->get_fast_wake_state() == nullptr)
+    return;
+  FastWakeState *state = global_deep_sleep->get_fast_wake_state();
+  state->ssid_hash = fnv1_hash(WiFi.SSID().c_str());
+  memcpy(state->bssid, WiFi.BSSID(), 6);
+  state->channel = WiFi.channel();
+  state->ip = uint32_t(WiFi.localIP());
+  state->gateway = uint32_t(WiFi.gatewayIP());
+  state->subnet = uint32_t(WiFi.subnetMask());
+  state->dns1 = uint32_t(WiFi.dnsIP(0));
+  state->dns2 = uint32_t(WiFi.dnsIP(1));
+}
+#endif
+
 void WiFiComponent::start_scanning() {
   this->action_started_ = millis();
   ESP_LOGD(TAG, "Starting scan...");
@@ -332,6 +389,9 @@ void WiFiComponent::check_connecting_finished() {
     ESP_LOGI(TAG, "WiFi connected!");
     this->print_connect_params_();
     this->status_clear_warning();
+#ifdef USE_DEEP_SLEEP
+    this->save_fast_wake_state_();
+#endif
 
     if (this->has_ap()) {
       ESP_LOGD(TAG, "Disabling AP...");
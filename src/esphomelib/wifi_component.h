@@ -206,6 +206,11 @@ class WiFiComponent : public Component {
  protected:
   void setup_ap_config();
   void print_connect_params_();
+#ifdef USE_DEEP_SLEEP
+  /// Connect directly to the network from before deep sleep, returns false if there's no fast wake state.
+  bool start_fast_wake_connecting_();
+  void save_fast_wake_state_();
+#endif
 
   bool wifi_mode_(optional<bool> sta, optional<bool> ap);
   bool wifi_disable_auto_connect_();